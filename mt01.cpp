@@ -1,59 +1,155 @@
 #include "mt01.h"
 #include <cstdlib>
+#include <charconv>
 #include <limits>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
 
-// Helpers
-static inline Process makeEmptyProcess() { return Process("", 0, 0, 0, 0); }
-
-// Ordenamiento simple por tiempo restante (burbuja)
-void sortByRemainingTime(vector<Process>& processes) {
-    for (int i = 0; i < (int)processes.size() - 1; i++) {
-        for (int j = 0; j < (int)processes.size() - 1 - i; j++) {
-            if (processes[j].getRemainingTime() > processes[j + 1].getRemainingTime()) {
-                Process temp = processes[j];
-                processes[j] = processes[j + 1];
-                processes[j + 1] = temp;
-            }
+// ---- LabelTable ----
+
+// Las etiquetas se guardan en bloques de tamano fijo que no se mueven. El
+// vector de bloques se reserva completo de entrada, asi que leer un id ya
+// publicado no compite con una insercion concurrente. Cada intern() suma una
+// referencia; un id liberado por release() se reutiliza para otro texto.
+static const int LABEL_BLOCK_BITS = 12;
+static const int LABEL_BLOCK_SIZE = 1 << LABEL_BLOCK_BITS;
+static const int LABEL_MAX_BLOCKS = 1 << 16;
+
+struct LabelEntry {
+    string text;
+    int refs;
+};
+
+struct LabelStore {
+    mutex lock;
+    unordered_map<string_view, int> ids;   // Vistas sobre los textos guardados
+    vector<LabelEntry*> blocks;
+    vector<int> freeIds;                   // Ids sin referencias, para reutilizar
+    int count;
+    
+    LabelStore() : count(0) { blocks.reserve(LABEL_MAX_BLOCKS); }
+    ~LabelStore() { for (size_t i = 0; i < blocks.size(); i++) delete[] blocks[i]; }
+    
+    LabelEntry& entry(int id) { return blocks[id >> LABEL_BLOCK_BITS][id & (LABEL_BLOCK_SIZE - 1)]; }
+    
+    int add(string_view text) {
+        unordered_map<string_view, int>::const_iterator found = ids.find(text);
+        if (found != ids.end()) {
+            entry(found->second).refs++;
+            return found->second;
+        }
+        int id;
+        if (!freeIds.empty()) {
+            id = freeIds.back();
+            freeIds.pop_back();
+        } else {
+            id = count++;
+            if ((id & (LABEL_BLOCK_SIZE - 1)) == 0) blocks.push_back(new LabelEntry[LABEL_BLOCK_SIZE]);
         }
+        LabelEntry& slot = entry(id);
+        slot.text.assign(text.data(), text.size());
+        slot.refs = 1;
+        ids[string_view(slot.text)] = id;
+        return id;
     }
+    
+    void remove(int id) {
+        LabelEntry& slot = entry(id);
+        if (--slot.refs > 0) return;
+        ids.erase(string_view(slot.text));
+        freeIds.push_back(id);
+    }
+};
+
+static LabelStore& labelStore() {
+    static LabelStore store;
+    return store;
+}
+
+int LabelTable::intern(string_view text) {
+    LabelStore& store = labelStore();
+    lock_guard<mutex> guard(store.lock);
+    return store.add(text);
+}
+
+// Varias etiquetas con un solo lock (un bloque completo del loader)
+void LabelTable::internAll(const vector<string_view>& texts, vector<int>& ids) {
+    LabelStore& store = labelStore();
+    lock_guard<mutex> guard(store.lock);
+    ids.resize(texts.size());
+    for (size_t i = 0; i < texts.size(); i++) ids[i] = store.add(texts[i]);
+}
+
+void LabelTable::release(int id) {
+    LabelStore& store = labelStore();
+    lock_guard<mutex> guard(store.lock);
+    store.remove(id);
+}
+
+const string& LabelTable::name(int id) {
+    return labelStore().entry(id).text;
+}
+
+int LabelTable::size() {
+    LabelStore& store = labelStore();
+    lock_guard<mutex> guard(store.lock);
+    return store.count - (int)store.freeIds.size();
 }
 
 // ---- Process ----
 
-Process::Process(string lbl, int bt, int at, int q, int pr) 
-    : label(lbl), burstTime(bt), arrivalTime(at), queueLevel(q), priority(pr),
-      waitingTime(0), completionTime(0), responseTime(0), turnaroundTime(0),
-      remainingTime(bt), hasStarted(false) {}
+Process::Process(const string& lbl, SimTime bt, SimTime at, int q, int pr) 
+    : labelId(LabelTable::intern(lbl)), burstTime(bt), arrivalTime(at), queueLevel(q), priority(pr),
+      waitingTime(0), completionTime(0), responseTime(0), turnaroundTime(0), ioTime(0), burstsId(-1) {}
+
+Process::Process(int lblId, SimTime bt, SimTime at, int q, int pr) 
+    : labelId(lblId), burstTime(bt), arrivalTime(at), queueLevel(q), priority(pr),
+      waitingTime(0), completionTime(0), responseTime(0), turnaroundTime(0), ioTime(0), burstsId(-1) {}
 
 // Getters
-string Process::getLabel() const { return label; }
-int Process::getBurstTime() const { return burstTime; }
-int Process::getArrivalTime() const { return arrivalTime; }
+const string& Process::getLabel() const { return LabelTable::name(labelId); }
+int Process::getLabelId() const { return labelId; }
+SimTime Process::getBurstTime() const { return burstTime; }
+SimTime Process::getArrivalTime() const { return arrivalTime; }
 int Process::getQueueLevel() const { return queueLevel; }
 int Process::getPriority() const { return priority; }
-int Process::getWaitingTime() const { return waitingTime; }
-int Process::getCompletionTime() const { return completionTime; }
-int Process::getResponseTime() const { return responseTime; }
-int Process::getTurnaroundTime() const { return turnaroundTime; }
-int Process::getRemainingTime() const { return remainingTime; }
-bool Process::getHasStarted() const { return hasStarted; }
+SimTime Process::getWaitingTime() const { return waitingTime; }
+SimTime Process::getCompletionTime() const { return completionTime; }
+SimTime Process::getResponseTime() const { return responseTime; }
+SimTime Process::getTurnaroundTime() const { return turnaroundTime; }
+SimTime Process::getIoTime() const { return ioTime; }
+int Process::getBurstsId() const { return burstsId; }
+bool Process::hasIo() const { return burstsId >= 0; }
 
 // Sets
-void Process::setWaitingTime(int wt) { waitingTime = wt; }
-void Process::setCompletionTime(int ct) { completionTime = ct; }
-void Process::setResponseTime(int rt) { responseTime = rt; }
-void Process::setTurnaroundTime(int tat) { turnaroundTime = tat; }
-void Process::setRemainingTime(int rt) { remainingTime = rt; }
-void Process::setHasStarted(bool started) { hasStarted = started; }
+void Process::setWaitingTime(SimTime wt) { waitingTime = wt; }
+void Process::setCompletionTime(SimTime ct) { completionTime = ct; }
+void Process::setResponseTime(SimTime rt) { responseTime = rt; }
+void Process::setTurnaroundTime(SimTime tat) { turnaroundTime = tat; }
 
+// Rafagas pares de CPU, impares de E/S
+void Process::setBursts(int id) {
+    const vector<int>& bursts = BurstTable::bursts(id);
+    burstsId = id;
+    burstTime = 0;
+    ioTime = 0;
+    for (int i = 0; i < (int)bursts.size(); i++) {
+        if (i % 2 == 0) burstTime += bursts[i];
+        else ioTime += bursts[i];
+    }
+}
+
+// El tiempo bloqueado en E/S no cuenta como espera
 void Process::calculateMetrics() {
     turnaroundTime = completionTime - arrivalTime;
-    waitingTime = turnaroundTime - burstTime;
+    waitingTime = turnaroundTime - burstTime - ioTime;
 }
 
 string Process::toString() const {
     stringstream ss;
-    ss << label << ";" << burstTime << ";" << arrivalTime << ";" << queueLevel 
+    ss << getLabel() << ";" << burstTime << ";" << arrivalTime << ";" << queueLevel 
        << ";" << priority << ";" << waitingTime << ";" << completionTime 
        << ";" << responseTime << ";" << turnaroundTime;
     return ss.str();
@@ -61,20 +157,187 @@ string Process::toString() const {
 
 // ---- ProcessQueue ----
 
+// Tickets por unidad de CPU en STRIDE: el pass crece STRIDE_SCALE / Pr por
+// unidad ejecutada (60 es divisible por 1..5, los strides son exactos)
+static const long long STRIDE_SCALE = 60;
+
+QueueLink makeQueueLink(const Process& p) {
+    int weight = min(max(p.getPriority(), 1), PRIORITY_LEVELS);
+    QueueLink link = { -1, -1, -1, 0, 0, 0, 0, 0, (unsigned char)weight, false };
+    return link;
+}
+
 ProcessQueue::ProcessQueue(SchedulingAlgorithm alg, int q) 
-    : algorithm(alg), quantum(q), currentIndex(0) {}
+    : algorithm(alg), quantum(q), cursor(-1), links(NULL), nextStamp(0), count(0),
+      head(-1), tail(-1), stampOffsets(NULL), segment(-1), basePass(0),
+      tickets(1, 0), totalTickets(0), randomState(1) {
+    if (algorithm == PRIORITY) {
+        bucketHead.assign(PRIORITY_LEVELS, -1);
+        bucketTail.assign(PRIORITY_LEVELS, -1);
+    }
+}
+
+void ProcessQueue::bindLinks(vector<QueueLink>* queueLinks, vector<long long>* offsets) {
+    links = queueLinks;
+    stampOffsets = offsets;
+    rebuildHeapKeys();
+}
+
+// Claves del monticulo desde los enlaces (al cargar un checkpoint o copiar)
+void ProcessQueue::rebuildHeapKeys() {
+    heapKeys.resize(heap.size());
+    heapStamps.resize(heap.size());
+    for (int i = 0; i < (int)heap.size(); i++) {
+        heapKeys[i] = (*links)[heap[i]].sortKey;
+        heapStamps[i] = (*links)[heap[i]].stamp;
+    }
+}
 
-void ProcessQueue::addProcess(Process p) {
-    processes.push_back(p);
+// Abre un tramo nuevo (desplazamiento 0) para las proximas inserciones
+void ProcessQueue::newSegment() {
+    segment = (int)stampOffsets->size();
+    stampOffsets->push_back(0);
+    ownedSegments.push_back(segment);
+}
+
+// Sello efectivo de un nodo de la lista RR
+long long ProcessQueue::stampOf(int handle) const {
+    const QueueLink& link = (*links)[handle];
+    return (*stampOffsets)[link.segment] + link.stamp;
+}
+
+bool ProcessQueue::isHeapOrdered() const {
+    return algorithm == SJF || algorithm == STCF || algorithm == STRIDE;
+}
+
+// Clave actual del orden del monticulo: tiempo restante o, en STRIDE, pass
+long long ProcessQueue::orderKey(const QueueLink& link) const {
+    return algorithm == STRIDE ? link.pass : link.key;
+}
+
+// Orden del monticulo: menor restante (o pass) primero; a igualdad, el mas antiguo
+bool ProcessQueue::heapLess(int a, int b) const {
+    const QueueLink& la = (*links)[a];
+    const QueueLink& lb = (*links)[b];
+    if (la.sortKey != lb.sortKey) return la.sortKey < lb.sortKey;
+    return la.stamp < lb.stamp;
+}
+
+void ProcessQueue::heapStore(int i, int handle, long long key, long long stamp) {
+    heap[i] = handle;
+    heapKeys[i] = key;
+    heapStamps[i] = stamp;
+    (*links)[handle].heapPos = i;
+}
+
+// Subir y bajar mueven el hueco y escriben el elemento una sola vez; el
+// orden que resulta es el mismo que con intercambios
+void ProcessQueue::siftUp(int i) {
+    int handle = heap[i];
+    long long key = heapKeys[i], stamp = heapStamps[i];
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (key > heapKeys[parent] || (key == heapKeys[parent] && stamp >= heapStamps[parent])) break;
+        heapStore(i, heap[parent], heapKeys[parent], heapStamps[parent]);
+        i = parent;
+    }
+    heapStore(i, handle, key, stamp);
+}
+
+void ProcessQueue::siftDown(int i) {
+    int n = (int)heap.size();
+    int handle = heap[i];
+    long long key = heapKeys[i], stamp = heapStamps[i];
+    while (true) {
+        int best = 2 * i + 1;
+        if (best >= n) break;
+        int right = best + 1;
+        if (right < n && (heapKeys[right] < heapKeys[best] ||
+                          (heapKeys[right] == heapKeys[best] && heapStamps[right] < heapStamps[best])))
+            best = right;
+        if (key < heapKeys[best] || (key == heapKeys[best] && stamp < heapStamps[best])) break;
+        heapStore(i, heap[best], heapKeys[best], heapStamps[best]);
+        i = best;
+    }
+    heapStore(i, handle, key, stamp);
+}
+
+// Equivale a reordenar la cola de forma estable por tiempo restante: solo los
+// procesos que ejecutaron desde el ultimo orden cambian de clave. Como su
+// restante bajo, quedan detras de los que ya tenian esa clave; entre ellos se
+// respeta el orden previo. Cada uno es un decrease-key O(log n).
+// Los que salieron de la cola desde entonces quedan en la lista sin la
+// marca (quitar no la recorre) y aca se saltean.
+void ProcessQueue::reorder() {
+    if (dirty.empty()) return;
+    if (dirty.size() > 1) {
+        sort(dirty.begin(), dirty.end(), [this](int a, int b) { return heapLess(a, b); });
+    }
+    for (int i = 0; i < (int)dirty.size(); i++) {
+        QueueLink& link = (*links)[dirty[i]];
+        if (!link.dirty || link.heapPos >= (int)heap.size() || heap[link.heapPos] != dirty[i]) continue;
+        link.sortKey = orderKey(link);
+        link.stamp = nextStamp++;
+        link.dirty = false;
+        int pos = link.heapPos;
+        heapKeys[pos] = link.sortKey;
+        heapStamps[pos] = link.stamp;
+        siftUp(pos);
+        siftDown(link.heapPos);
+    }
+    dirty.clear();
+}
+
+void ProcessQueue::addProcess(int handle, SimTime remaining) {
+    QueueLink& link = (*links)[handle];
+    link.key = remaining;
+    link.dirty = false;
+    count++;
     
-    // Ordenar segun el algoritmo
-    if (algorithm == SJF || algorithm == STCF) {
-        sortByRemainingTime(processes);
+    // Insertar segun el algoritmo
+    if (isHeapOrdered()) {
+        reorder();
+        // STRIDE: entra con el menor pass de la cola, detras de los que ya
+        // lo tenian (sin ventaja acumulada ni deuda de otro nivel)
+        if (algorithm == STRIDE) link.pass = heap.empty() ? basePass : heapKeys[0];
+        link.sortKey = orderKey(link);
+        link.stamp = nextStamp++;
+        link.heapPos = (int)heap.size();
+        heap.push_back(handle);
+        heapKeys.push_back(link.sortKey);
+        heapStamps.push_back(link.stamp);
+        siftUp(link.heapPos);
+    } else if (algorithm == PRIORITY) {
+        // Al final de la lista de su prioridad
+        int b = link.weight - 1;
+        link.prev = bucketTail[b];
+        link.next = -1;
+        if (bucketTail[b] >= 0) (*links)[bucketTail[b]].next = handle;
+        else bucketHead[b] = handle;
+        bucketTail[b] = handle;
+    } else if (algorithm == LOTTERY) {
+        // Nuevo lugar al final; su nodo del arbol cubre los lugares
+        // (n - lowbit(n), n], que ya estan sumados en los prefijos
+        link.heapPos = (int)slots.size();
+        slots.push_back(handle);
+        int n = (int)slots.size();
+        tickets.push_back(link.weight + ticketPrefix(n - 1) - ticketPrefix(n - (n & -n)));
+        totalTickets += link.weight;
+    } else {
+        // Al final de la lista; el sello crece con la posicion
+        if (segment < 0) newSegment();
+        link.segment = segment;
+        link.stamp = nextStamp++;
+        link.prev = tail;
+        link.next = -1;
+        if (tail >= 0) (*links)[tail].next = handle;
+        else head = handle;
+        tail = handle;
     }
 }
 
-Process ProcessQueue::getNextProcess(int currentTime) {
-    if (processes.empty()) return makeEmptyProcess();
+int ProcessQueue::getNextProcess(SimTime currentTime) {
+    if (count == 0) return -1;
     
     switch (algorithm) {
         case ROUND_ROBIN:
@@ -83,358 +346,1135 @@ Process ProcessQueue::getNextProcess(int currentTime) {
             return shortestJobFirst(currentTime);
         case STCF:
             return shortestTimeToCompletion(currentTime);
+        case PRIORITY:
+            return strictPriority(currentTime);
+        case STRIDE:
+            return strideScheduling(currentTime);
+        case LOTTERY:
+            return lottery(currentTime);
         default:
-            return makeEmptyProcess();
+            return -1;
     }
 }
 
-Process ProcessQueue::roundRobin(int currentTime) {
-    if (processes.empty()) return makeEmptyProcess();
+int ProcessQueue::roundRobin(SimTime currentTime) {
+    if (count == 0) return -1;
     
-    Process selected = processes[currentIndex];
-    currentIndex = (currentIndex + 1) % (int)processes.size();
+    int selected = (cursor >= 0) ? cursor : head;
+    cursor = (*links)[selected].next; // -1 vuelve a la cabeza
     return selected;
 }
 
-Process ProcessQueue::shortestJobFirst(int currentTime) {
-    if (processes.empty()) return makeEmptyProcess();
+int ProcessQueue::shortestJobFirst(SimTime currentTime) {
+    if (count == 0) return -1;
     
-    // Ya esta ordenado por tiempo restante
-    return processes[0];
+    // La cima del monticulo segun el orden de la ultima insercion
+    return heap[0];
 }
 
-Process ProcessQueue::shortestTimeToCompletion(int currentTime) {
-    if (processes.empty()) return makeEmptyProcess();
+int ProcessQueue::shortestTimeToCompletion(SimTime currentTime) {
+    if (count == 0) return -1;
     
     // Reordenar por tiempo restante (STCF es preventivo)
-    sortByRemainingTime(processes);
+    reorder();
+    
+    return heap[0];
+}
+
+// La cabeza de la lista de mayor Pr; no consume turno (una consulta repetida
+// devuelve el mismo proceso hasta que rote o salga)
+int ProcessQueue::strictPriority(SimTime) {
+    if (count == 0) return -1;
+    
+    for (int b = PRIORITY_LEVELS - 1; b >= 0; b--) {
+        if (bucketHead[b] >= 0) return bucketHead[b];
+    }
+    return -1;
+}
+
+// El de menor pass; el que ejecuto ya fue cobrado en updateRemaining/rotate
+int ProcessQueue::strideScheduling(SimTime) {
+    if (count == 0) return -1;
+    
+    reorder();
+    basePass = heapKeys[0];
+    return heap[0];
+}
+
+// Sortea un ticket y baja por el arbol hasta el lugar que lo contiene
+int ProcessQueue::lottery(SimTime) {
+    if (count == 0) return -1;
     
-    return processes[0];
+    long long ticket = (long long)(nextRandom() % (unsigned long long)totalTickets);
+    int n = (int)slots.size();
+    int step = 1;
+    while (step * 2 <= n) step *= 2;
+    int pos = 0;   // Lugares ya saltados (su suma es <= ticket)
+    for (; step > 0; step /= 2) {
+        if (pos + step <= n && tickets[pos + step] <= ticket) {
+            pos += step;
+            ticket -= tickets[pos];
+        }
+    }
+    return slots[pos];
+}
+
+// Suma 'delta' a los tickets del lugar 'slot' (0-based)
+void ProcessQueue::addTickets(int slot, long long delta) {
+    for (int i = slot + 1; i < (int)tickets.size(); i += i & -i) tickets[i] += delta;
+}
+
+// Tickets de los primeros 'n' lugares
+long long ProcessQueue::ticketPrefix(int n) const {
+    long long sum = 0;
+    for (int i = n; i > 0; i -= i & -i) sum += tickets[i];
+    return sum;
+}
+
+unsigned long long ProcessQueue::nextRandom() {
+    unsigned long long z = (randomState += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
 }
 
 bool ProcessQueue::isEmpty() const {
-    return processes.empty();
+    return count == 0;
 }
 
 int ProcessQueue::size() const {
-    return processes.size();
+    return count;
 }
 
-void ProcessQueue::removeProcess(Process p) {
-    for (int i = 0; i < (int)processes.size(); i++) {
-        if (processes[i].getLabel() == p.getLabel()) {
-            processes.erase(processes.begin() + i);
-            if (currentIndex >= (int)processes.size() && !processes.empty()) currentIndex = 0;
-            break;
+void ProcessQueue::removeProcess(int handle) {
+    QueueLink& link = (*links)[handle];
+    count--;
+    
+    if (algorithm == PRIORITY) {
+        int b = link.weight - 1;
+        if (link.prev >= 0) (*links)[link.prev].next = link.next;
+        else bucketHead[b] = link.next;
+        if (link.next >= 0) (*links)[link.next].prev = link.prev;
+        else bucketTail[b] = link.prev;
+        return;
+    }
+    
+    if (algorithm == LOTTERY) {
+        // El ultimo lugar pasa al que queda libre y el arbol pierde su ultimo
+        // nodo (ningun otro nodo lo incluye)
+        int pos = link.heapPos;
+        int last = (int)slots.size() - 1;
+        if (pos != last) {
+            int moved = slots[last];
+            addTickets(pos, (*links)[moved].weight - link.weight);
+            slots[pos] = moved;
+            (*links)[moved].heapPos = pos;
         }
+        slots.pop_back();
+        tickets.pop_back();
+        totalTickets -= link.weight;
+        return;
+    }
+    
+    if (!isHeapOrdered()) {
+        // El turno es una posicion: si se quita el proceso en turno o uno
+        // anterior, la posicion pasa a apuntar al siguiente (o a la cabeza)
+        int current = (cursor >= 0) ? cursor : head;
+        if (handle == current) cursor = link.next;
+        else if (stampOf(handle) < stampOf(current)) cursor = (*links)[current].next;
+        
+        if (link.prev >= 0) (*links)[link.prev].next = link.next;
+        else head = link.next;
+        if (link.next >= 0) (*links)[link.next].prev = link.prev;
+        else tail = link.prev;
+        if (count == 0) cursor = -1;
+        return;
+    }
+    
+    // Quitar del monticulo
+    // El ultimo ocupa su lugar y se reubica
+    int pos = link.heapPos;
+    int lastPos = (int)heap.size() - 1;
+    if (pos != lastPos) heapStore(pos, heap[lastPos], heapKeys[lastPos], heapStamps[lastPos]);
+    heap.pop_back();
+    heapKeys.pop_back();
+    heapStamps.pop_back();
+    if (pos < (int)heap.size()) {
+        siftUp(pos);
+        siftDown(pos);
+    }
+    link.dirty = false;
+}
+
+// Registra el nuevo tiempo restante de un proceso encolado; SJF/STCF lo
+// reubican en el siguiente reordenamiento. En STRIDE la CPU usada desde la
+// ultima vez se cobra en el pass.
+void ProcessQueue::updateRemaining(int handle, SimTime remaining) {
+    QueueLink& link = (*links)[handle];
+    if (algorithm == STRIDE) link.pass += (link.key - remaining) * (STRIDE_SCALE / link.weight);
+    link.key = remaining;
+    if (isHeapOrdered() && !link.dirty && orderKey(link) != link.sortKey) {
+        link.dirty = true;
+        dirty.push_back(handle);
     }
 }
 
+// Capacidad para 'processes' procesos a la vez: despues, insertar y
+// reordenar no piden memoria
+void ProcessQueue::reserve(int processes) {
+    if (algorithm == PRIORITY) return;
+    if (algorithm == LOTTERY) {
+        slots.reserve(processes);
+        tickets.reserve(processes + 1);
+        return;
+    }
+    if (!isHeapOrdered()) {
+        if (segment < 0) newSegment();
+        return;
+    }
+    heap.reserve(processes);
+    heapKeys.reserve(processes);
+    heapStamps.reserve(processes);
+    dirty.reserve(processes);
+}
+
+// Pasa todos los procesos de 'other' al final de esta cola, en su orden.
+// Entre dos colas RR es un empalme de listas: O(1) mas un ajuste por tramo
+// de sellos, sin recorrer los procesos. A un monticulo SJF/STCF entran de
+// una vez (ver appendToHeap). Con otros algoritmos se mueven de a uno, en el
+// orden en que 'other' los elegiria; si 'other' es un monticulo, ese orden
+// sale de ordenarlo (una lista RR o un turno de STRIDE dependen del orden
+// completo, no solo del minimo).
+void ProcessQueue::appendAll(ProcessQueue& other) {
+    if (other.count == 0) return;
+    
+    if (algorithm == SJF || algorithm == STCF) {
+        appendToHeap(other);
+        return;
+    }
+    
+    if (algorithm == ROUND_ROBIN && other.algorithm == ROUND_ROBIN) {
+        if (segment < 0) newSegment();
+        // Correr los tramos de 'other' para que sus sellos queden despues de
+        // los de esta lista, conservando su orden relativo
+        long long delta = nextStamp - other.stampOf(other.head);
+        for (int i = 0; i < (int)other.ownedSegments.size(); i++) {
+            (*stampOffsets)[other.ownedSegments[i]] += delta;
+            ownedSegments.push_back(other.ownedSegments[i]);
+        }
+        nextStamp = other.stampOf(other.tail) + 1;
+        
+        if (tail >= 0) (*links)[tail].next = other.head;
+        else head = other.head;
+        (*links)[other.head].prev = tail;
+        tail = other.tail;
+        count += other.count;
+        
+        other.head = other.tail = other.cursor = -1;
+        other.count = 0;
+        other.nextStamp = 0;
+        other.ownedSegments.clear();
+        other.newSegment();
+        return;
+    }
+    
+    vector<int> moving;
+    other.collectInOrder(moving);
+    for (int i = 0; i < (int)moving.size(); i++) {
+        other.removeProcess(moving[i]);
+        addProcess(moving[i], (*links)[moving[i]].key);
+    }
+}
+
+// Agrega los procesos de 'other' al monticulo sin ordenarlos. Aca solo
+// importa el orden entre procesos con el mismo restante: van detras de los
+// que ya estaban y entre ellos en el orden de 'other'. Si 'other' es SJF/STCF
+// ese orden es el de sus sellos, asi que basta correrlos por encima de
+// nextStamp (O(m)); con otros algoritmos se recorren en orden de eleccion,
+// que es lineal salvo en STRIDE. Despues, con pocos procesos nuevos se sube
+// cada uno (O(m log n)) y si no se reconstruye el monticulo (O(n + m)).
+void ProcessQueue::appendToHeap(ProcessQueue& other) {
+    reorder();
+    int oldSize = (int)heap.size();
+    
+    if (other.algorithm == SJF || other.algorithm == STCF) {
+        other.reorder();
+        long long first = other.heapStamps[0], last = other.heapStamps[0];
+        for (int i = 1; i < (int)other.heap.size(); i++) {
+            first = min(first, other.heapStamps[i]);
+            last = max(last, other.heapStamps[i]);
+        }
+        for (int i = 0; i < (int)other.heap.size(); i++) {
+            QueueLink& link = (*links)[other.heap[i]];
+            link.sortKey = link.key;
+            link.stamp = nextStamp + (other.heapStamps[i] - first);
+            link.heapPos = (int)heap.size();
+            heap.push_back(other.heap[i]);
+            heapKeys.push_back(link.sortKey);
+            heapStamps.push_back(link.stamp);
+        }
+        nextStamp += last - first + 1;
+        other.heap.clear();
+        other.heapKeys.clear();
+        other.heapStamps.clear();
+        other.count = 0;
+    } else {
+        vector<int> moving;
+        other.collectInOrder(moving);
+        for (int i = 0; i < (int)moving.size(); i++) {
+            other.removeProcess(moving[i]);
+            QueueLink& link = (*links)[moving[i]];
+            link.dirty = false;
+            link.sortKey = link.key;
+            link.stamp = nextStamp++;
+            link.heapPos = (int)heap.size();
+            heap.push_back(moving[i]);
+            heapKeys.push_back(link.sortKey);
+            heapStamps.push_back(link.stamp);
+        }
+    }
+    
+    int added = (int)heap.size() - oldSize;
+    count += added;
+    if ((long long)added * 8 < oldSize) {
+        for (int i = oldSize; i < (int)heap.size(); i++) siftUp(i);
+    } else {
+        for (int i = (int)heap.size() / 2 - 1; i >= 0; i--) siftDown(i);
+    }
+}
+
+// Los procesos de la cola en orden de eleccion (LOTTERY: por lugar)
+void ProcessQueue::collectInOrder(vector<int>& order) {
+    if (isHeapOrdered()) {
+        reorder();
+        order = heap;
+        sort(order.begin(), order.end(), [this](int a, int b) { return heapLess(a, b); });
+    } else if (algorithm == PRIORITY) {
+        for (int b = PRIORITY_LEVELS - 1; b >= 0; b--)
+            for (int h = bucketHead[b]; h >= 0; h = (*links)[h].next) order.push_back(h);
+    } else if (algorithm == LOTTERY) {
+        order = slots;
+    } else {
+        for (int h = head; h >= 0; h = (*links)[h].next) order.push_back(h);
+    }
+}
+
+// Un proceso que esta cola elegiria de los ultimos (el final de la lista RR
+// o de la prioridad mas baja, una hoja del monticulo o el ultimo lugar del
+// sorteo), distinto de 'exclude'; -1 si no hay
+int ProcessQueue::lastProcess(int exclude) const {
+    if (algorithm == PRIORITY) {
+        for (int b = 0; b < PRIORITY_LEVELS; b++) {
+            int t = bucketTail[b];
+            if (t < 0) continue;
+            if (t != exclude) return t;
+            if ((*links)[t].prev >= 0) return (*links)[t].prev;
+        }
+        return -1;
+    }
+    if (algorithm == LOTTERY) {
+        for (int i = (int)slots.size() - 1; i >= 0 && i >= (int)slots.size() - 2; i--)
+            if (slots[i] != exclude) return slots[i];
+        return -1;
+    }
+    if (isHeapOrdered()) {
+        for (int i = (int)heap.size() - 1; i >= 0 && i >= (int)heap.size() - 2; i--)
+            if (heap[i] != exclude) return heap[i];
+        return -1;
+    }
+    if (tail >= 0 && tail != exclude) return tail;
+    return tail >= 0 ? (*links)[tail].prev : -1;
+}
+
+// Fin de quantum sin cambiar de nivel: el proceso pasa al final de su turno.
+// RR y PRIORITY lo mueven al final de su lista; STRIDE solo cobra la CPU
+// usada (el pass lo reubica) y LOTTERY no cambia (el proximo sorteo decide).
+void ProcessQueue::rotate(int handle, SimTime remaining) {
+    if (algorithm == STRIDE || algorithm == LOTTERY) {
+        updateRemaining(handle, remaining);
+        return;
+    }
+    removeProcess(handle);
+    addProcess(handle, remaining);
+}
+
 int ProcessQueue::getQuantum() const { return quantum; }
+void ProcessQueue::setQuantum(int q) { quantum = q; }
+void ProcessQueue::setSeed(unsigned long long seed) { randomState = seed; }
 SchedulingAlgorithm ProcessQueue::getAlgorithm() const { return algorithm; }
 
+bool algorithmUsesQuantum(SchedulingAlgorithm algorithm) {
+    return algorithm == ROUND_ROBIN || algorithm == PRIORITY || algorithm == STRIDE || algorithm == LOTTERY;
+}
+
+bool ProcessQueue::usesQuantum() const { return algorithmUsesQuantum(algorithm); }
+
+bool ProcessQueue::preemptsWithin() const {
+    return algorithm == STCF || algorithm == PRIORITY;
+}
+
+// ---- Instrumentacion ----
+
+// Reloj de los cronometros, en nanosegundos
+static long long statClock() {
+    return chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Puntos de medicion dentro de advanceWith<Stats>: con Stats = false no
+// generan codigo. STAT_START/STAT_STOP cronometran un bloque sin salidas
+// intermedias.
+#define STAT(code) do { if (Stats) { code; } } while (0)
+#define STAT_START(start) long long start = Stats ? statClock() : 0
+#define STAT_STOP(timer, start) STAT(stats.timerNanos[timer] += statClock() - start; stats.timerCalls[timer]++)
+
 // ---- MLFQ_Scheduler ----
 
-MLFQ_Scheduler::MLFQ_Scheduler(int schemeNumber) 
-    : currentTime(0), scheme(schemeNumber) {
-    
-    // Inicializar las 4 colas segun el esquema seleccionado
+// Niveles de cada esquema predefinido
+vector<QueueConfig> schemeLevels(int scheme) {
+    vector<QueueConfig> levels;
     switch (scheme) {
         case 1: // RR(1), RR(3), RR(4), SJF
-            queues.push_back(ProcessQueue(ROUND_ROBIN, 1));
-            queues.push_back(ProcessQueue(ROUND_ROBIN, 3));
-            queues.push_back(ProcessQueue(ROUND_ROBIN, 4));
-            queues.push_back(ProcessQueue(SJF, 0));
+            levels.push_back(QueueConfig(ROUND_ROBIN, 1));
+            levels.push_back(QueueConfig(ROUND_ROBIN, 3));
+            levels.push_back(QueueConfig(ROUND_ROBIN, 4));
+            levels.push_back(QueueConfig(SJF, 0));
             break;
         case 2: // RR(2), RR(3), RR(4), STCF
-            queues.push_back(ProcessQueue(ROUND_ROBIN, 2));
-            queues.push_back(ProcessQueue(ROUND_ROBIN, 3));
-            queues.push_back(ProcessQueue(ROUND_ROBIN, 4));
-            queues.push_back(ProcessQueue(STCF, 0));
+            levels.push_back(QueueConfig(ROUND_ROBIN, 2));
+            levels.push_back(QueueConfig(ROUND_ROBIN, 3));
+            levels.push_back(QueueConfig(ROUND_ROBIN, 4));
+            levels.push_back(QueueConfig(STCF, 0));
             break;
         case 3: // RR(3), RR(5), RR(6), RR(20)
-            queues.push_back(ProcessQueue(ROUND_ROBIN, 3));
-            queues.push_back(ProcessQueue(ROUND_ROBIN, 5));
-            queues.push_back(ProcessQueue(ROUND_ROBIN, 6));
-            queues.push_back(ProcessQueue(ROUND_ROBIN, 20));
+            levels.push_back(QueueConfig(ROUND_ROBIN, 3));
+            levels.push_back(QueueConfig(ROUND_ROBIN, 5));
+            levels.push_back(QueueConfig(ROUND_ROBIN, 6));
+            levels.push_back(QueueConfig(ROUND_ROBIN, 20));
             break;
         default:
             // Esquema por defecto
-            queues.push_back(ProcessQueue(ROUND_ROBIN, 1));
-            queues.push_back(ProcessQueue(ROUND_ROBIN, 3));
-            queues.push_back(ProcessQueue(ROUND_ROBIN, 4));
-            queues.push_back(ProcessQueue(SJF, 0));
+            levels.push_back(QueueConfig(ROUND_ROBIN, 1));
+            levels.push_back(QueueConfig(ROUND_ROBIN, 3));
+            levels.push_back(QueueConfig(ROUND_ROBIN, 4));
+            levels.push_back(QueueConfig(SJF, 0));
             break;
     }
+    return levels;
+}
+
+string trimSpaces(const string& text) {
+    size_t first = text.find_first_not_of(" \t");
+    if (first == string::npos) return "";
+    size_t last = text.find_last_not_of(" \t");
+    return text.substr(first, last - first + 1);
+}
+
+template <class Integer>
+static bool parseIntegerText(const string& text, Integer& value) {
+    const char* first = text.data();
+    const char* last = first + text.size();
+    if (first == last) return false;
+    from_chars_result result = from_chars(first, last, value);
+    return result.ec == errc() && result.ptr == last;
+}
+
+bool parseIntText(const string& text, int& value) { return parseIntegerText(text, value); }
+bool parseIntText(const string& text, long long& value) { return parseIntegerText(text, value); }
+
+// Nombre de los algoritmos con quantum en el texto de los niveles
+static const char* quantumPolicyName(SchedulingAlgorithm algorithm) {
+    switch (algorithm) {
+        case PRIORITY: return "PRIO";
+        case STRIDE: return "STRIDE";
+        case LOTTERY: return "LOTTERY";
+        default: return "RR";
+    }
+}
+
+// Lee una lista de niveles separados por coma: RR(q), PRIO(q), STRIDE(q),
+// LOTTERY(q), SJF o STCF
+bool parseLevels(const string& text, vector<QueueConfig>& levels) {
+    static const SchedulingAlgorithm withQuantum[] = { ROUND_ROBIN, PRIORITY, STRIDE, LOTTERY };
+    vector<QueueConfig> parsed;
+    stringstream ss(text);
+    string token;
+    while (getline(ss, token, ',')) {
+        token = trimSpaces(token);
+        if (token == "SJF") {
+            parsed.push_back(QueueConfig(SJF, 0));
+            continue;
+        }
+        if (token == "STCF") {
+            parsed.push_back(QueueConfig(STCF, 0));
+            continue;
+        }
+        bool matched = false;
+        for (int a = 0; a < 4 && !matched; a++) {
+            string prefix = string(quantumPolicyName(withQuantum[a])) + "(";
+            if (token.size() > prefix.size() && token.compare(0, prefix.size(), prefix) == 0 &&
+                token[token.size() - 1] == ')') {
+                int q;
+                if (!parseIntText(token.substr(prefix.size(), token.size() - prefix.size() - 1), q) || q <= 0)
+                    return false;
+                parsed.push_back(QueueConfig(withQuantum[a], q));
+                matched = true;
+            }
+        }
+        if (!matched) return false;
+    }
+    if (parsed.empty()) return false;
+    levels = parsed;
+    return true;
+}
+
+string describeLevels(const vector<QueueConfig>& levels) {
+    string text;
+    for (int i = 0; i < (int)levels.size(); i++) {
+        if (i > 0) text += ",";
+        switch (levels[i].algorithm) {
+            case SJF: text += "SJF"; break;
+            case STCF: text += "STCF"; break;
+            default:
+                text += string(quantumPolicyName(levels[i].algorithm)) + "(" + to_string(levels[i].quantum) + ")";
+                break;
+        }
+    }
+    return text;
+}
+
+// Lee reglas de retroalimentacion: "off", "demote", "boost=S" o ambas
+// separadas por coma
+bool parseFeedback(const string& text, FeedbackConfig& feedback) {
+    FeedbackConfig parsed;
+    stringstream ss(text);
+    string token;
+    while (getline(ss, token, ',')) {
+        token = trimSpaces(token);
+        if (token == "off") {
+            parsed = FeedbackConfig();
+        } else if (token == "demote") {
+            parsed.demoteOnExpiry = true;
+        } else if (token.compare(0, 6, "boost=") == 0) {
+            if (!parseIntText(token.substr(6), parsed.boostPeriod) || parsed.boostPeriod <= 0) return false;
+        } else {
+            return false;
+        }
+    }
+    feedback = parsed;
+    return true;
+}
+
+string describeFeedback(const FeedbackConfig& feedback) {
+    string text;
+    if (feedback.demoteOnExpiry) text = "demote";
+    if (feedback.boostPeriod > 0) text += (text.empty() ? "" : ",") + string("boost=") + to_string(feedback.boostPeriod);
+    return text.empty() ? "off" : text;
+}
+
+MLFQ_Scheduler::MLFQ_Scheduler(int schemeNumber) 
+    : arrivalCursor(0), arrivalsSorted(true), currentTime(0), executedSlices(0), scheme(schemeNumber),
+      eventDriven(false), echoOnLoad(true), loadThreads(0), timeline(make_shared<TimelineSink>()),
+      retainFinished(true), hasRunning(false), running(-1), runningQueue(-1),
+      rrQuantumUsed(0), nextBoost(-1), checkpointEvery(0), instrumented(false), randomSeed(1),
+      busyTime(0), lastBoost(-1) {
+    
+    // Inicializar las 4 colas segun el esquema seleccionado
+    initQueues(schemeLevels(scheme));
+}
+
+// Scheduler con niveles arbitrarios (scheme = 0)
+MLFQ_Scheduler::MLFQ_Scheduler(const vector<QueueConfig>& levels)
+    : arrivalCursor(0), arrivalsSorted(true), currentTime(0), executedSlices(0), scheme(0),
+      eventDriven(false), echoOnLoad(true), loadThreads(0), timeline(make_shared<TimelineSink>()),
+      retainFinished(true), hasRunning(false), running(-1), runningQueue(-1),
+      rrQuantumUsed(0), nextBoost(-1), checkpointEvery(0), instrumented(false), randomSeed(1),
+      busyTime(0), lastBoost(-1) {
+    initQueues(levels);
+}
+
+void MLFQ_Scheduler::initQueues(const vector<QueueConfig>& levels) {
+    levelConfig = levels;
+    queues.clear();
+    stampOffsets.clear();
+    for (int i = 0; i < (int)levels.size(); i++) {
+        queues.push_back(ProcessQueue(levels[i].algorithm, levels[i].quantum));
+        queues[i].setSeed(levelSeed(i));
+    }
+    metrics = MetricsAccumulator((int)queues.size());
+    rebindQueues();
+}
+
+MLFQ_Scheduler::MLFQ_Scheduler(const MLFQ_Scheduler& other)
+    : levelConfig(other.levelConfig), queues(other.queues), allProcesses(other.allProcesses),
+      runStates(other.runStates), queueLinks(other.queueLinks),
+      stampOffsets(other.stampOffsets), feedback(other.feedback),
+      pendingArrivals(other.pendingArrivals), arrivalCursor(other.arrivalCursor),
+      arrivalsSorted(other.arrivalsSorted), finishedProcesses(other.finishedProcesses),
+      metrics(other.metrics),
+      currentTime(other.currentTime), executedSlices(other.executedSlices),
+      scheme(other.scheme), eventDriven(other.eventDriven),
+      echoOnLoad(other.echoOnLoad), loadThreads(other.loadThreads), timeline(other.timeline),
+      retainFinished(other.retainFinished), hasRunning(other.hasRunning), running(other.running),
+      runningQueue(other.runningQueue), rrQuantumUsed(other.rrQuantumUsed),
+      nextBoost(other.nextBoost), freeHandles(other.freeHandles), onComplete(other.onComplete),
+      checkpointFile(other.checkpointFile), checkpointEvery(other.checkpointEvery),
+      instrumented(other.instrumented), stats(other.stats), randomSeed(other.randomSeed),
+      blocked(other.blocked), burstIndex(other.burstIndex), woken(other.woken),
+      busyTime(other.busyTime), lastBoost(other.lastBoost), intervals(other.intervals) {
+    rebindQueues();
+}
+
+MLFQ_Scheduler& MLFQ_Scheduler::operator=(const MLFQ_Scheduler& other) {
+    if (this != &other) {
+        levelConfig = other.levelConfig;
+        queues = other.queues;
+        allProcesses = other.allProcesses;
+        runStates = other.runStates;
+        queueLinks = other.queueLinks;
+        stampOffsets = other.stampOffsets;
+        feedback = other.feedback;
+        pendingArrivals = other.pendingArrivals;
+        arrivalCursor = other.arrivalCursor;
+        arrivalsSorted = other.arrivalsSorted;
+        finishedProcesses = other.finishedProcesses;
+        metrics = other.metrics;
+        currentTime = other.currentTime;
+        executedSlices = other.executedSlices;
+        scheme = other.scheme;
+        eventDriven = other.eventDriven;
+        echoOnLoad = other.echoOnLoad;
+        loadThreads = other.loadThreads;
+        timeline = other.timeline;
+        retainFinished = other.retainFinished;
+        hasRunning = other.hasRunning;
+        running = other.running;
+        runningQueue = other.runningQueue;
+        rrQuantumUsed = other.rrQuantumUsed;
+        nextBoost = other.nextBoost;
+        freeHandles = other.freeHandles;
+        onComplete = other.onComplete;
+        checkpointFile = other.checkpointFile;
+        checkpointEvery = other.checkpointEvery;
+        instrumented = other.instrumented;
+        stats = other.stats;
+        randomSeed = other.randomSeed;
+        blocked = other.blocked;
+        burstIndex = other.burstIndex;
+        woken = other.woken;
+        busyTime = other.busyTime;
+        lastBoost = other.lastBoost;
+        intervals = other.intervals;
+        rebindQueues();
+    }
+    return *this;
 }
 
 MLFQ_Scheduler::~MLFQ_Scheduler() {
     // No hay punteros que liberar
 }
 
-void MLFQ_Scheduler::addProcess(Process p) {
+// Semilla del sorteo de cada nivel (LOTTERY): secuencias distintas por nivel
+unsigned long long MLFQ_Scheduler::levelSeed(int level) const {
+    return randomSeed + (unsigned long long)level * 0x632BE59BD9B4E019ULL;
+}
+
+void MLFQ_Scheduler::setRandomSeed(unsigned long long seed) {
+    randomSeed = seed;
+    for (int i = 0; i < (int)queues.size(); i++) queues[i].setSeed(levelSeed(i));
+}
+
+// Las colas guardan un puntero a los enlaces de este scheduler
+void MLFQ_Scheduler::rebindQueues() {
+    for (int i = 0; i < (int)queues.size(); i++) queues[i].bindLinks(&queueLinks, &stampOffsets);
+}
+
+// Boost: todos los procesos listos pasan al primer nivel, detras de los que
+// ya estaban y en el orden de sus niveles. Con colas RR son empalmes de
+// listas, O(niveles) sin importar cuantos procesos haya.
+void MLFQ_Scheduler::boostAll() {
+    for (int i = 1; i < (int)queues.size(); i++) queues[0].appendAll(queues[i]);
+}
+
+RunState makeRunState(const Process& p, int level) {
+    SimTime first = p.hasIo() ? BurstTable::bursts(p.getBurstsId())[0] : p.getBurstTime();
+    RunState state = { first, p.getArrivalTime(), level, 0 };
+    return state;
+}
+
+// Cola de llegada 0-based (los niveles fuera de rango van a la primera)
+int MLFQ_Scheduler::levelOf(const Process& p) const {
+    int queueLevel = p.getQueueLevel() - 1;
+    return (queueLevel >= 0 && queueLevel < (int)queues.size()) ? queueLevel : 0;
+}
+
+// Agrega un proceso a una simulacion en curso. Las llegadas pendientes
+// siguen ordenadas si llega en orden (el caso normal en linea); los handles
+// de procesos terminados se reutilizan y el prefijo ya procesado de la lista
+// de llegadas se descarta, asi la memoria no crece con el total de procesos.
+int MLFQ_Scheduler::submit(const Process& p) {
+    if (arrivalCursor >= 4096 && arrivalCursor * 2 >= (int)pendingArrivals.size()) {
+        pendingArrivals.erase(pendingArrivals.begin(), pendingArrivals.begin() + arrivalCursor);
+        arrivalCursor = 0;
+    }
+    SimTime last = arrivalCursor < (int)pendingArrivals.size() ? runStates[pendingArrivals.back()].arrival : -1;
+    bool sorted = arrivalsSorted && max(p.getArrivalTime(), currentTime) >= max(last, currentTime);
+    
+    int handle;
+    if (freeHandles.empty()) {
+        handle = addProcess(p);
+    } else {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+        allProcesses[handle] = p;
+        runStates[handle] = makeRunState(p, levelOf(p));
+        queueLinks[handle] = makeQueueLink(p);
+        burstIndex[handle] = 0;
+        pendingArrivals.push_back(handle);
+    }
+    arrivalsSorted = sorted;
+    return handle;
+}
+
+// Guarda el proceso en el almacen y devuelve su handle
+int MLFQ_Scheduler::addProcess(const Process& p) {
+    int handle = (int)allProcesses.size();
     allProcesses.push_back(p);
+    runStates.push_back(makeRunState(p, levelOf(p)));
+    queueLinks.push_back(makeQueueLink(p));
+    burstIndex.push_back(0);
+    blocked.resize(handle + 1);
+    pendingArrivals.push_back(handle);
+    arrivalsSorted = false;
+    return handle;
+}
+
+// Ordena (de forma estable) las llegadas que faltan. Todo lo que tenga AT
+// anterior al reloj llega junto en el proximo tick en orden de entrada, por
+// eso la clave se acota por abajo con currentTime.
+void MLFQ_Scheduler::sortPendingArrivals() {
+    SimTime now = currentTime;
+    const vector<RunState>& states = runStates;
+    stable_sort(pendingArrivals.begin() + arrivalCursor, pendingArrivals.end(),
+                [&states, now](int a, int b) {
+                    return max(states[a].arrival, now) < max(states[b].arrival, now);
+                });
+    arrivalsSorted = true;
+}
+
+// Deja reservada toda la memoria que usa el bucle de simulate(): colas con
+// lugar para todos sus procesos, llegadas ordenadas y espacio para los
+// terminados. Despues de esto el bucle no pide memoria en ningun tick.
+void MLFQ_Scheduler::prepareRun() {
+    if (!arrivalsSorted) sortPendingArrivals();
+    int pending = (int)pendingArrivals.size() - arrivalCursor;
+    for (int i = 0; i < (int)queues.size(); i++) queues[i].reserve(queues[i].size() + pending);
+    if (retainFinished) finishedProcesses.reserve(finishedProcesses.size() + allProcesses.size());
+    freeHandles.reserve(allProcesses.size());
+    woken.reserve(allProcesses.size());
 }
 
 void MLFQ_Scheduler::simulate() {
-    cout << "Iniciando simulacion MLFQ - Esquema " << scheme << endl;
+    prepareRun();
+    if (timeline->getLevel() >= TIMELINE_SUMMARY) {
+        timeline->summary("Iniciando simulacion MLFQ - " +
+                          (scheme > 0 ? "Esquema " + to_string(scheme) : describeLevels(levelConfig)) +
+                          (feedback.demoteOnExpiry || feedback.boostPeriod > 0
+                               ? " [" + describeFeedback(feedback) + "]" : "") +
+                          (eventDriven ? " (motor por eventos)" : ""));
+    }
 
-    // Estado del proceso en CPU
-    bool hasRunning = false;
-    Process running = Process("", 0, 0, 0, 0);
-    int runningQueue = -1;
-    int rrQuantumUsed = 0; // unidades usadas del quantum en RR
+    if (checkpointEvery > 0) {
+        // Cortar en multiplos de checkpointEvery y guardar el estado en cada uno
+        while (hasWork()) {
+            SimTime until = (currentTime / checkpointEvery + 1) * checkpointEvery;
+            while (hasWork() && currentTime < until) advance(until);
+            if (!hasWork()) break;
+            string name = checkpointFile;
+            size_t mark = name.find("{t}");
+            if (mark != string::npos) name.replace(mark, 3, to_string(currentTime));
+            // El timeline va por su buffer: vaciarlo antes de escribir en la
+            // consola para que el aviso quede despues de los eventos previos
+            timeline->flush();
+            if (saveCheckpoint(name)) cout << "Checkpoint en t=" << currentTime << ": " << name << endl;
+        }
+    } else {
+        drain();
+    }
 
-    auto anyWorkLeft = [&]() -> bool {
-        if (!allProcesses.empty()) return true;
-        for (int i = 0; i < (int)queues.size(); i++) if (!queues[i].isEmpty()) return true;
-        return false;
-    };
-
-    while (anyWorkLeft()) {
-        // Llegadas en este tiempo
-        checkArrivals();
-
-        // Preempcion por llegada a cola de mayor prioridad
-        if (hasRunning) {
-            for (int i = 0; i < runningQueue; i++) {
-                if (!queues[i].isEmpty()) {
-                    // Devolver el proceso en ejecucion a su cola (sin democion)
-                    updateProcessInQueue(runningQueue, running);
-                    hasRunning = false;
-                    rrQuantumUsed = 0;
-                    break;
-                }
-            }
+    if (timeline->getLevel() >= TIMELINE_SUMMARY)
+        timeline->summary("Simulacion completada en tiempo: " + to_string(currentTime));
+    timeline->flush();
+}
+
+// Aqui y no en mt01_io.cpp: el bucle la consulta en cada tick y asi se inlinea
+int TimerWheel::size() const { return count; }
+
+// Quedan procesos por llegar, en alguna cola o bloqueados en E/S
+bool MLFQ_Scheduler::hasWork() const {
+    if (arrivalCursor < (int)pendingArrivals.size()) return true;
+    if (blocked.size() > 0) return true;
+    for (int i = 0; i < (int)queues.size(); i++) if (!queues[i].isEmpty()) return true;
+    return false;
+}
+
+bool MLFQ_Scheduler::step() {
+    if (!hasWork()) return false;
+    advance(numeric_limits<SimTime>::max());
+    return true;
+}
+
+// Sin trabajo el reloj salta directo a 'time' (un boost en el hueco no tiene
+// efecto); con trabajo, el motor por eventos corta la ultima porcion en 'time'
+void MLFQ_Scheduler::runUntil(SimTime time) {
+    while (currentTime < time) {
+        if (hasWork()) {
+            advance(time);
+            continue;
         }
+        currentTime = time;
+        if (nextBoost >= 0 && nextBoost < currentTime)
+            nextBoost = (currentTime + feedback.boostPeriod - 1) / feedback.boostPeriod * feedback.boostPeriod;
+    }
+}
+
+void MLFQ_Scheduler::drain() {
+    while (hasWork()) advance(numeric_limits<SimTime>::max());
+}
+
+// Una iteracion del bucle de simulacion: llegadas, boost, preempcion,
+// seleccion y ejecucion. El reloj no pasa de 'horizon'. La version sin
+// instrumentacion es el bucle de siempre; -DMLFQ_NO_STATS quita la otra.
+void MLFQ_Scheduler::advance(SimTime horizon) {
+#ifndef MLFQ_NO_STATS
+    if (instrumented) {
+        advanceWith<true>(horizon);
+        return;
+    }
+#endif
+    advanceWith<false>(horizon);
+}
+
+template <bool Stats>
+void MLFQ_Scheduler::advanceWith(SimTime horizon) {
+    // Llegadas en este tiempo y, despues, los que terminan su E/S
+    STAT_START(arrivalsStart);
+    checkArrivals();
+    if (blocked.size() > 0) checkWakeups();
+    STAT_STOP(TIMER_ARRIVALS, arrivalsStart);
+    
+    // Boost, preempciones y eleccion se cronometran juntos
+    SimTime boostPeriod = feedback.boostPeriod;
+    STAT_START(selectionStart);
 
-        // Para STCF, re-evaluar la eleccion dentro de su cola en cada tick
-        if (hasRunning && queues[runningQueue].getAlgorithm() == STCF) {
-            // Seleccionar el de menor remaining en esa cola
-            Process candidate = queues[runningQueue].getNextProcess(currentTime);
-            if (candidate.getLabel() != running.getLabel()) {
-                // Cambiar por el mas corto
-                updateProcessInQueue(runningQueue, running);
-                running = candidate;
+    // Boost periodico. Si el proceso en CPU estaba en un nivel inferior
+    // sube con los demas y vuelve a competir por turno en el primero.
+    if (nextBoost >= 0 && currentTime >= nextBoost) {
+        if (hasRunning && runningQueue > 0) {
+            updateWith<Stats>(runningQueue, running);
+            if (intervals) intervals->stop(END_BOOST);
+            hasRunning = false;
+            rrQuantumUsed = 0;
+        }
+        boostAll();
+        lastBoost = currentTime;
+        STAT(stats.boosts++);
+        nextBoost = (currentTime / boostPeriod + 1) * boostPeriod;
+    }
+
+    // Preempcion por llegada a cola de mayor prioridad
+    if (hasRunning) {
+        for (int i = 0; i < runningQueue; i++) {
+            if (!queues[i].isEmpty()) {
+                // Devolver el proceso en ejecucion a su cola (sin democion)
+                updateWith<Stats>(runningQueue, running);
+                if (intervals) intervals->stop(END_ARRIVAL);
+                hasRunning = false;
                 rrQuantumUsed = 0;
-                // Si primera vez en CPU, setear RT
-                if (!running.getHasStarted()) {
-                    running.setResponseTime(currentTime - running.getArrivalTime());
-                    running.setHasStarted(true);
-                    updateProcessInQueue(runningQueue, running);
-                }
+                STAT(stats.arrivalPreemptions++);
+                break;
+            }
+        }
+    }
+
+    // Para STCF y PRIORITY, re-evaluar la eleccion dentro de su cola en cada tick
+    if (hasRunning && queues[runningQueue].preemptsWithin()) {
+        // Seleccionar el de menor remaining (o el de mayor Pr) en esa cola
+        int candidate = queues[runningQueue].getNextProcess(currentTime);
+        if (candidate != running) {
+            // Cambiar por el mas corto (o el de mayor Pr)
+            updateWith<Stats>(runningQueue, running);
+            if (intervals) intervals->stop(END_PREEMPT);
+            running = candidate;
+            rrQuantumUsed = 0;
+            STAT(if (queues[runningQueue].getAlgorithm() == STCF) stats.stcfPreemptions++;
+                 else stats.priorityPreemptions++);
+            // Si primera vez en CPU, setear RT
+            RunState& state = runStates[running];
+            if (!state.started) {
+                allProcesses[running].setResponseTime(currentTime - state.arrival);
+                state.started = 1;
             }
         }
+    }
 
-        // Elegir un nuevo proceso si no hay uno corriendo
-        if (!hasRunning) {
-            runningQueue = -1;
-            for (int i = 0; i < (int)queues.size(); i++) {
-                if (!queues[i].isEmpty()) {
-                    running = queues[i].getNextProcess(currentTime);
-                    runningQueue = i;
-                    hasRunning = true;
-                    rrQuantumUsed = 0;
-                    if (!running.getHasStarted()) {
-                        running.setResponseTime(currentTime - running.getArrivalTime());
-                        running.setHasStarted(true);
-                        updateProcessInQueue(runningQueue, running);
-                    }
-                    break;
+    // Elegir un nuevo proceso si no hay uno corriendo
+    if (!hasRunning) {
+        runningQueue = -1;
+        for (int i = 0; i < (int)queues.size(); i++) {
+            if (!queues[i].isEmpty()) {
+                running = queues[i].getNextProcess(currentTime);
+                runningQueue = i;
+                hasRunning = true;
+                rrQuantumUsed = 0;
+                RunState& state = runStates[running];
+                if (!state.started) {
+                    allProcesses[running].setResponseTime(currentTime - state.arrival);
+                    state.started = 1;
                 }
+                break;
             }
         }
+    }
+    STAT_STOP(TIMER_SELECTION, selectionStart);
 
-        // Si aun no hay listo, avanzar el reloj
-        if (!hasRunning) { currentTime++; continue; }
+    // Si aun no hay listo, avanzar el reloj (o saltar a la siguiente llegada
+    // o despertar)
+    if (!hasRunning) {
+        SimTime nextEvent = eventDriven ? nextEventTime() : -1;
+        SimTime idleUntil = nextEvent > currentTime ? min(nextEvent, horizon) : currentTime + 1;
+        // Con procesos bloqueados el boost si cuenta (los sube al despertar)
+        if (nextBoost >= 0 && blocked.size() > 0) idleUntil = min(idleUntil, nextBoost);
+        STAT(stats.recordIdle(idleUntil - currentTime));
+        currentTime = idleUntil;
+        // Un boost dentro de un hueco sin procesos no tiene efecto
+        if (nextBoost >= 0 && nextBoost < currentTime)
+            nextBoost = (currentTime + boostPeriod - 1) / boostPeriod * boostPeriod;
+        return;
+    }
 
-        // Ejecutar exactamente 1 unidad de tiempo y luego re-evaluar
-        executeProcess(running, 1);
-        if (queues[runningQueue].getAlgorithm() == ROUND_ROBIN) rrQuantumUsed++;
+    // Motor por ticks: ejecutar exactamente 1 unidad y re-evaluar.
+    // Motor por eventos: ejecutar hasta el siguiente punto donde la decision
+    // puede cambiar (llegada, fin de quantum o finalizacion). En STCF el
+    // proceso en CPU sigue siendo el de menor restante mientras no llegue
+    // nadie (en PRIORITY, el de mayor Pr), asi que su preempcion interna solo
+    // ocurre en una llegada.
+    RunState& state = runStates[running];
+    bool quantum = queues[runningQueue].usesQuantum();
+    SimTime timeSlice = 1;
+    if (eventDriven) {
+        timeSlice = state.remaining;
+        if (quantum)
+            timeSlice = min(timeSlice, (SimTime)(queues[runningQueue].getQuantum() - rrQuantumUsed));
+        SimTime nextEvent = nextEventTime();
+        if (nextEvent >= 0) timeSlice = min(timeSlice, nextEvent - currentTime);
+        if (nextBoost >= 0) timeSlice = min(timeSlice, nextBoost - currentTime);
+        timeSlice = min(timeSlice, horizon - currentTime);
+        if (timeSlice < 1) timeSlice = 1;
+    }
+    executeProcess(running, timeSlice);
+    STAT(stats.recordRun(queues, running, runningQueue, timeSlice));
+    if (quantum) rrQuantumUsed += (int)timeSlice;   // No pasa del quantum
 
-        // Termino?
-        if (running.getRemainingTime() == 0) {
-            running.setCompletionTime(currentTime);
-            running.calculateMetrics();
-            finishedProcesses.push_back(running);
-            queues[runningQueue].removeProcess(running);
-            hasRunning = false;
-            rrQuantumUsed = 0;
-            continue;
+    // Termino su rafaga? Si le queda E/S se bloquea; si no, termino
+    if (state.remaining == 0) {
+        if (allProcesses[running].hasIo() && blockForIo(running)) {
+            if (intervals) intervals->stop(END_IO);
+            STAT(stats.ioBlocks++);
+            return;
         }
+        if (intervals) intervals->stop(END_FINISH);
+        Process& current = allProcesses[running];
+        current.setCompletionTime(currentTime);
+        current.calculateMetrics();
+        metrics.record(current, runningQueue);
+        if (retainFinished) finishedProcesses.push_back(current);
+        queues[runningQueue].removeProcess(running);
+        hasRunning = false;
+        rrQuantumUsed = 0;
+        freeHandles.push_back(running);
+        if (onComplete) onComplete(current);
+        return;
+    }
 
-        // Si es RR y agoto quantum, rotar dentro de la misma cola (sin democión)
-        if (queues[runningQueue].getAlgorithm() == ROUND_ROBIN &&
-            rrQuantumUsed == queues[runningQueue].getQuantum()) {
+    // Si agoto el quantum, rotar al final de su turno o, con democion,
+    // bajar al nivel siguiente (el ultimo nivel se queda)
+    if (quantum && rrQuantumUsed == queues[runningQueue].getQuantum()) {
+        int nextQ = runningQueue;
+        if (feedback.demoteOnExpiry && nextQ + 1 < (int)queues.size()) nextQ++;
+        if (nextQ == runningQueue) {
+            queues[runningQueue].rotate(running, state.remaining);
+        } else {
             queues[runningQueue].removeProcess(running);
-            int nextQ = runningQueue; // mantener en su misma cola
-            queues[nextQ].addProcess(running);
-            hasRunning = false;
-            rrQuantumUsed = 0;
-            continue;
+            queues[nextQ].addProcess(running, state.remaining);
         }
-
-        // Caso contrario, actualizar el proceso en su misma cola y seguir al siguiente tick
-        updateProcessInQueue(runningQueue, running);
+        if (intervals) intervals->stop(nextQ == runningQueue ? END_QUANTUM : END_DEMOTE);
+        STAT(stats.rrRotations++; if (nextQ != runningQueue) stats.demotions++);
+        hasRunning = false;
+        rrQuantumUsed = 0;
+        return;
     }
 
-    cout << "Simulacion completada en tiempo: " << currentTime << endl;
+    // Caso contrario, actualizar el proceso en su misma cola y seguir al siguiente tick
+    updateWith<Stats>(runningQueue, running);
 }
 
-void MLFQ_Scheduler::executeProcess(Process& p, int timeSlice) {
-    cout << "Tiempo " << currentTime << ": Ejecutando proceso "
-         << p.getLabel() << " por " << timeSlice << " unidades" << endl;
+void MLFQ_Scheduler::executeProcess(int handle, SimTime timeSlice) {
+    timeline->run(allProcesses[handle], currentTime, timeSlice);
+    if (intervals) intervals->run(allProcesses[handle], handle, runningQueue, currentTime, timeSlice);
     
     currentTime += timeSlice;
-    p.setRemainingTime(p.getRemainingTime() - timeSlice);
+    runStates[handle].remaining -= timeSlice;
+    executedSlices++;
+    busyTime += timeSlice;
 }
 
-void MLFQ_Scheduler::checkArrivals() {
-    for (int i = 0; i < (int)allProcesses.size();) {
-        if (allProcesses[i].getArrivalTime() <= currentTime) {
-            int queueLevel = allProcesses[i].getQueueLevel() - 1; // 0-based
-            if (queueLevel >= 0 && queueLevel < (int)queues.size())
-                queues[queueLevel].addProcess(allProcesses[i]);
-            else
-                queues[0].addProcess(allProcesses[i]);
-            allProcesses.erase(allProcesses.begin() + i);
-        } else {
-            i++;
+// Fin de una rafaga de CPU con E/S pendiente: el proceso sale de su cola y
+// espera en la rueda. Vuelve a la misma cola (no agoto su quantum), salvo
+// que haya un boost mientras esta bloqueado. false si era la ultima rafaga.
+bool MLFQ_Scheduler::blockForIo(int handle) {
+    const vector<int>& bursts = BurstTable::bursts(allProcesses[handle].getBurstsId());
+    int index = burstIndex[handle];
+    if (index + 1 >= (int)bursts.size()) return false;
+    
+    RunState& state = runStates[handle];
+    queues[runningQueue].removeProcess(handle);
+    state.level = runningQueue;
+    state.remaining = bursts[index + 2];
+    burstIndex[handle] = index + 2;
+    blocked.schedule(handle, currentTime + bursts[index + 1]);
+    hasRunning = false;
+    rrQuantumUsed = 0;
+    return true;
+}
+
+// Los que terminan su E/S en este tiempo vuelven a su cola, en el orden en
+// que se bloquearon. Un boost posterior al bloqueo los manda al primer nivel.
+void MLFQ_Scheduler::checkWakeups() {
+    woken.clear();
+    blocked.advance(currentTime, woken);
+    for (int i = 0; i < (int)woken.size(); i++) {
+        int handle = woken[i];
+        RunState& state = runStates[handle];
+        if (lastBoost >= 0) {
+            int io = BurstTable::bursts(allProcesses[handle].getBurstsId())[burstIndex[handle] - 1];
+            if (lastBoost >= blocked.wakeTime(handle) - io) state.level = 0;
         }
+        queues[state.level].addProcess(handle, state.remaining);
     }
 }
 
-// Actualiza un proceso ya presente en la cola (por etiqueta)
-void MLFQ_Scheduler::updateProcessInQueue(int queueIndex, const Process& updatedProcess) {
-    for (int i = 0; i < queues[queueIndex].size(); i++) {
-        // Necesitamos acceder directamente al vector de procesos
-        // Por simplicidad, removemos y agregamos el proceso actualizado
-        if (queues[queueIndex].processes[i].getLabel() == updatedProcess.getLabel()) {
-            queues[queueIndex].processes[i] = updatedProcess;
-            break;
-        }
+// Proxima llegada o despertar (-1 si no hay ninguno)
+SimTime MLFQ_Scheduler::nextEventTime() const {
+    SimTime next = nextArrivalTime();
+    if (blocked.size() > 0) {
+        SimTime wake = blocked.nextWake();
+        if (next < 0 || wake < next) next = wake;
     }
+    return next;
 }
 
-bool MLFQ_Scheduler::loadProcessesFromFile(const string& filename) {
-    FILE* file = fopen(filename.c_str(), "r");
-    if (file == NULL) {
-        cout << "Error: No se pudo abrir el archivo " << filename << endl;
-        return false;
+// Avanza el cursor de llegadas: O(llegadas en este tiempo)
+void MLFQ_Scheduler::checkArrivals() {
+    if (!arrivalsSorted) sortPendingArrivals();
+    while (arrivalCursor < (int)pendingArrivals.size()) {
+        int handle = pendingArrivals[arrivalCursor];
+        const RunState& state = runStates[handle];
+        if (state.arrival > currentTime) break;
+        queues[state.level].addProcess(handle, state.remaining);
+        arrivalCursor++;
     }
-    
-    char line[256];
-    while (fgets(line, sizeof(line), file)) {
-        // Convertir char array a string
-        string lineStr(line);
-        
-        // Remover salto de linea
-        if (!lineStr.empty() && lineStr[lineStr.length() - 1] == '\n') {
-            lineStr = lineStr.substr(0, lineStr.length() - 1);
-        }
-        
-        // Ignorar lineas de comentario
-        if (lineStr.empty() || lineStr[0] == '#') continue;
-        
-        // Parsear linea: etiqueta;BT;AT;Q;Priority
-        stringstream ss(lineStr);
-        string label, btStr, atStr, qStr, prStr;
-        
-        if (getline(ss, label, ';') && 
-            getline(ss, btStr, ';') && 
-            getline(ss, atStr, ';') && 
-            getline(ss, qStr, ';') && 
-            getline(ss, prStr, ';')) {
-            
-            int bt = atoi(btStr.c_str());
-            int at = atoi(atStr.c_str());
-            int q = atoi(qStr.c_str());
-            int pr = atoi(prStr.c_str());
-            
-            Process process(label, bt, at, q, pr);
-            addProcess(process);
-            
-            cout << "Proceso cargado: " << label << " BT=" << bt 
-                 << " AT=" << at << " Q=" << q << " Pr=" << pr << endl;
+}
+
+// Tiempo de la siguiente llegada pendiente (-1 si no quedan), en O(1)
+// una vez ordenadas
+SimTime MLFQ_Scheduler::nextArrivalTime() const {
+    if (arrivalCursor >= (int)pendingArrivals.size()) return -1;
+    if (!arrivalsSorted) {
+        SimTime next = -1;
+        for (int i = arrivalCursor; i < (int)pendingArrivals.size(); i++) {
+            SimTime at = runStates[pendingArrivals[i]].arrival;
+            if (next < 0 || at < next) next = at;
         }
+        return next;
     }
-    
-    fclose(file);
-    return true;
+    return runStates[pendingArrivals[arrivalCursor]].arrival;
 }
 
-void MLFQ_Scheduler::saveResultsToFile(const string& filename) {
+// El estado vive en el almacen; la cola solo necesita el nuevo restante
+void MLFQ_Scheduler::updateProcessInQueue(int queueIndex, int handle) {
+    queues[queueIndex].updateRemaining(handle, runStates[handle].remaining);
+}
+
+// updateProcessInQueue con su cronometro
+template <bool Stats>
+void MLFQ_Scheduler::updateWith(int queueIndex, int handle) {
+    STAT_START(updateStart);
+    updateProcessInQueue(queueIndex, handle);
+    STAT_STOP(TIMER_UPDATE, updateStart);
+}
+
+// ---- Resultados ----
+
+// Cabecera del .out
+void writeResultsHeader(FILE* file) {
+    fprintf(file, "# etiqueta; BT; AT; Q; Pr; WT; CT; RT; TAT\n");
+}
+
+// Promedios desde las metricas acumuladas (no requieren los procesos)
+void writeAveragesLine(FILE* file, const MetricsAccumulator& metrics) {
+    const MetricsSummary& total = metrics.getOverall();
+    if (total.count > 0) {
+        fprintf(file, "WT=%.1f; CT=%.1f; RT=%.1f; TAT=%.1f;",
+                total.averageWT(), total.averageCT(), total.averageRT(), total.averageTAT());
+        // Solo con rafagas de E/S (sin ellas la linea es la de siempre)
+        if (total.totalIO > 0) fprintf(file, " IO=%.1f;", total.averageIO());
+        fprintf(file, "\n");
+    }
+}
+
+// Contenido del .out: una linea por proceso terminado y los promedios
+void writeResults(FILE* file, const vector<Process>& finished, const MetricsAccumulator& metrics,
+                  int threads) {
+    writeResultsHeader(file);
+    writeResultLines(file, finished, threads);
+    writeAveragesLine(file, metrics);
+}
+
+bool writeResultsFile(const string& filename, const vector<Process>& finished,
+                      const MetricsAccumulator& metrics) {
     FILE* file = fopen(filename.c_str(), "w");
     if (file == NULL) {
         cout << "Error: No se pudo crear el archivo " << filename << endl;
-        return;
-    }
-    
-    fprintf(file, "# etiqueta; BT; AT; Q; Pr; WT; CT; RT; TAT\n");
-    
-    double totalWT = 0, totalCT = 0, totalRT = 0, totalTAT = 0;
-    
-    for (int i = 0; i < (int)finishedProcesses.size(); i++) {
-        Process p = finishedProcesses[i];
-        fprintf(file, "%s;%d;%d;%d;%d;%d;%d;%d;%d\n",
-                p.getLabel().c_str(),
-                p.getBurstTime(),
-                p.getArrivalTime(),
-                p.getQueueLevel(),
-                p.getPriority(),
-                p.getWaitingTime(),
-                p.getCompletionTime(),
-                p.getResponseTime(),
-                p.getTurnaroundTime());
-        
-        totalWT += p.getWaitingTime();
-        totalCT += p.getCompletionTime();
-        totalRT += p.getResponseTime();
-        totalTAT += p.getTurnaroundTime();
-    }
-    
-    int numProcesses = (int)finishedProcesses.size();
-    if (numProcesses > 0) {
-        fprintf(file, "WT=%.1f; CT=%.1f; RT=%.1f; TAT=%.1f;\n",
-                (totalWT / numProcesses),
-                (totalCT / numProcesses),
-                (totalRT / numProcesses),
-                (totalTAT / numProcesses));
+        return false;
     }
-    
+    writeResults(file, finished, metrics);
     fclose(file);
     cout << "Resultados guardados en: " << filename << endl;
+    return true;
 }
 
-void MLFQ_Scheduler::calculateAverages() {
-    if (finishedProcesses.empty()) return;
-    
-    double totalWT = 0, totalCT = 0, totalRT = 0, totalTAT = 0;
-    
-    for (int i = 0; i < (int)finishedProcesses.size(); i++) {
-        Process p = finishedProcesses[i];
-        totalWT += p.getWaitingTime();
-        totalCT += p.getCompletionTime();
-        totalRT += p.getResponseTime();
-        totalTAT += p.getTurnaroundTime();
-    }
-    
-    int numProcesses = (int)finishedProcesses.size();
+void printAverages(const MetricsAccumulator& metrics) {
+    const MetricsSummary& total = metrics.getOverall();
+    if (total.count == 0) return;
     
     cout << "\n=== METRICAS PROMEDIO ===" << endl;
-    printf("Tiempo de Espera Promedio (WT): %.2f\n", (totalWT / numProcesses));
-    printf("Tiempo de Finalizacion Promedio (CT): %.2f\n", (totalCT / numProcesses));
-    printf("Tiempo de Respuesta Promedio (RT): %.2f\n", (totalRT / numProcesses));
-    printf("Tiempo de Retorno Promedio (TAT): %.2f\n", (totalTAT / numProcesses));
+    printf("Tiempo de Espera Promedio (WT): %.2f\n", total.averageWT());
+    printf("Tiempo de Finalizacion Promedio (CT): %.2f\n", total.averageCT());
+    printf("Tiempo de Respuesta Promedio (RT): %.2f\n", total.averageRT());
+    printf("Tiempo de Retorno Promedio (TAT): %.2f\n", total.averageTAT());
+    if (total.totalIO > 0) printf("Tiempo en E/S Promedio (IO): %.2f\n", total.averageIO());
+    
+    metrics.printPercentiles();
 }
 
-void MLFQ_Scheduler::printResults() {
+void printResultsTable(const vector<Process>& finished, const MetricsAccumulator& metrics) {
     cout << "\n=== RESULTADOS DE LA SIMULACION ===" << endl;
     cout << "Proceso\tBT\tAT\tQ\tPr\tWT\tCT\tRT\tTAT" << endl;
     cout << "-------\t--\t--\t-\t--\t--\t--\t--\t---" << endl;
     
-    for (int i = 0; i < (int)finishedProcesses.size(); i++) {
-        Process p = finishedProcesses[i];
+    for (int i = 0; i < (int)finished.size(); i++) {
+        const Process& p = finished[i];
         cout << p.getLabel() << "\t" << p.getBurstTime() << "\t" 
              << p.getArrivalTime() << "\t" << p.getQueueLevel() << "\t"
              << p.getPriority() << "\t" << p.getWaitingTime() << "\t"
@@ -442,76 +1482,117 @@ void MLFQ_Scheduler::printResults() {
              << p.getTurnaroundTime() << endl;
     }
     
-    calculateAverages();
+    printAverages(metrics);
 }
 
-int MLFQ_Scheduler::getCurrentTime() const { return currentTime; }
-vector<Process> MLFQ_Scheduler::getFinishedProcesses() const { return finishedProcesses; }
+void MLFQ_Scheduler::saveResultsToFile(const string& filename) {
+    writeResultsFile(filename, finishedProcesses, metrics);
+}
 
-// ---- MAIN ----
+void MLFQ_Scheduler::calculateAverages() {
+    printAverages(metrics);
+}
 
-int main() {
-    cout << "=== SIMULADOR MLFQ (Multilevel Feedback Queue) ===" << endl;
-    // Permitir al usuario seleccionar el esquema de colas
-    int scheme = 2;
-    cout << "Seleccione el esquema (1, 2 o 3):" << endl;
-    cout << "  1) RR(1), RR(3), RR(4), SJF" << endl;
-    cout << "  2) RR(2), RR(3), RR(4), STCF" << endl;
-    cout << "  3) RR(3), RR(5), RR(6), RR(20)" << endl;
-    cout << "Ingrese opcion [1-3] (Enter para 2 por defecto): ";
-    string schemeInput;
-    getline(cin, schemeInput);
-    if (schemeInput.empty()) {
-        scheme = 2;
-    } else {
-        // Si previamente se usó >> para leer, puede quedar un salto pendiente; intentar parsear robustamente
-        stringstream ss(schemeInput);
-        int opt = 2;
-        if (ss >> opt) {
-            if (opt >= 1 && opt <= 3) scheme = opt; else scheme = 2;
-        }
+void MLFQ_Scheduler::printResults() {
+    printResultsTable(finishedProcesses, metrics);
+    if (currentTime > 0) {
+        printf("Utilizacion de CPU: %.2f%% (%lld de %lld unidades)\n",
+               100.0 * busyTime / currentTime, busyTime, (long long)currentTime);
     }
-    switch (scheme) {
-        case 1:
-            cout << "Usando esquema 1: RR(1), RR(3), RR(4), SJF" << endl;
-            break;
-        case 2:
-            cout << "Usando esquema 2: RR(2), RR(3), RR(4), STCF" << endl;
-            break;
-        case 3:
-            cout << "Usando esquema 3: RR(3), RR(5), RR(6), RR(20)" << endl;
-            break;
-        default:
-            cout << "Opcion invalida, usando esquema 2 por defecto: RR(2), RR(3), RR(4), STCF" << endl;
-            scheme = 2;
-            break;
+}
+
+void MLFQ_Scheduler::setEventDriven(bool enabled) { eventDriven = enabled; }
+bool MLFQ_Scheduler::isEventDriven() const { return eventDriven; }
+void MLFQ_Scheduler::setLoadEcho(bool enabled) { echoOnLoad = enabled; }
+void MLFQ_Scheduler::setLoadThreads(int threads) { loadThreads = threads; }
+void MLFQ_Scheduler::setTimeline(shared_ptr<TimelineSink> sink) { timeline = sink; }
+void MLFQ_Scheduler::setIntervalTrace(shared_ptr<IntervalTraceWriter> writer) { intervals = writer; }
+void MLFQ_Scheduler::setRetainFinished(bool enabled) { retainFinished = enabled; }
+// Copia para seguir desde este punto por separado: no hereda el callback y
+// tiene su propio timeline apagado, asi varias copias pueden correr en
+// paralelo sin compartir nada
+MLFQ_Scheduler MLFQ_Scheduler::fork() const {
+    MLFQ_Scheduler copy(*this);
+    copy.onComplete = nullptr;
+    copy.timeline = make_shared<TimelineSink>(TIMELINE_OFF);
+    copy.intervals = nullptr;
+    copy.checkpointEvery = 0;
+    return copy;
+}
+
+// Cambia la configuracion de los niveles a mitad de simulacion (misma
+// cantidad de niveles). Un nivel que cambia de algoritmo pasa sus procesos a
+// una cola nueva en el orden de la anterior; si el proceso en CPU ya uso el
+// nuevo quantum, su turno termina ahora como si hubiera agotado el quantum.
+bool MLFQ_Scheduler::setLevels(const vector<QueueConfig>& levels) {
+    if (levels.size() != queues.size()) return false;
+    for (int i = 0; i < (int)levels.size(); i++) {
+        if (algorithmUsesQuantum(levels[i].algorithm) && levels[i].quantum <= 0) return false;
     }
-    
-    string inputFile, outputFile;
-    cout << "Ingrese el nombre del archivo de entrada: ";
-    cin >> inputFile;
-    cout << "Ingrese el nombre del archivo de salida: ";
-    cin >> outputFile;
-    // Limpiar el buffer por si quedan saltos de linea para futuros getline
-    cin.ignore(numeric_limits<streamsize>::max(), '\n');
-    
-    // Crear el scheduler
-    MLFQ_Scheduler scheduler(scheme);
-    
-    // Cargar procesos desde archivo
-    if (!scheduler.loadProcessesFromFile(inputFile)) {
-        cout << "Error cargando el archivo de entrada." << endl;
-        return 1;
+    for (int i = 0; i < (int)levels.size(); i++) {
+        if (levels[i].algorithm == queues[i].getAlgorithm()) {
+            queues[i].setQuantum(levels[i].quantum);
+            continue;
+        }
+        ProcessQueue rebuilt(levels[i].algorithm, levels[i].quantum);
+        rebuilt.bindLinks(&queueLinks, &stampOffsets);
+        rebuilt.setSeed(levelSeed(i));
+        rebuilt.reserve(queues[i].size());
+        rebuilt.appendAll(queues[i]);
+        queues[i] = rebuilt;
+        if (hasRunning && runningQueue == i) rrQuantumUsed = 0;
     }
+    levelConfig = levels;
+    scheme = 0;
     
-    // Ejecutar simulación
-    scheduler.simulate();
-    
-    // Mostrar resultados
-    scheduler.printResults();
-    
-    // Guardar resultados
-    scheduler.saveResultsToFile(outputFile);
-    
-    return 0;
-}
\ No newline at end of file
+    if (hasRunning && queues[runningQueue].usesQuantum() &&
+        rrQuantumUsed >= queues[runningQueue].getQuantum()) {
+        int nextQ = runningQueue;
+        if (feedback.demoteOnExpiry && nextQ + 1 < (int)queues.size()) nextQ++;
+        if (nextQ == runningQueue) {
+            queues[runningQueue].rotate(running, runStates[running].remaining);
+        } else {
+            queues[runningQueue].removeProcess(running);
+            queues[nextQ].addProcess(running, runStates[running].remaining);
+        }
+        if (intervals) intervals->stop(nextQ == runningQueue ? END_QUANTUM : END_DEMOTE);
+        hasRunning = false;
+        rrQuantumUsed = 0;
+    }
+    return true;
+}
+
+const vector<QueueConfig>& MLFQ_Scheduler::getLevels() const { return levelConfig; }
+
+void MLFQ_Scheduler::setCheckpointInterval(const string& filename, SimTime every) {
+    checkpointFile = filename;
+    checkpointEvery = filename.empty() ? 0 : max((SimTime)0, every);
+}
+
+void MLFQ_Scheduler::setCompletionCallback(const function<void(const Process&)>& callback) { onComplete = callback; }
+
+// El primer boost es el multiplo de boostPeriod siguiente al reloj actual
+void MLFQ_Scheduler::setFeedback(const FeedbackConfig& rules) {
+    feedback = rules;
+    nextBoost = feedback.boostPeriod > 0 ? (currentTime / feedback.boostPeriod + 1) * feedback.boostPeriod : -1;
+}
+const FeedbackConfig& MLFQ_Scheduler::getFeedback() const { return feedback; }
+
+void MLFQ_Scheduler::setInstrumentation(bool enabled) {
+    if (enabled) stats = SchedulerStats((int)queues.size());
+    instrumented = enabled;
+}
+
+bool MLFQ_Scheduler::isInstrumented() const { return instrumented; }
+const SchedulerStats& MLFQ_Scheduler::getStats() const { return stats; }
+
+bool MLFQ_Scheduler::saveStats(const string& filename) const {
+    return stats.writeJson(filename, levelConfig, eventDriven, currentTime, executedSlices);
+}
+
+SimTime MLFQ_Scheduler::getCurrentTime() const { return currentTime; }
+long long MLFQ_Scheduler::getBusyTime() const { return busyTime; }
+int MLFQ_Scheduler::getBlockedCount() const { return blocked.size(); }
+long long MLFQ_Scheduler::getExecutedSlices() const { return executedSlices; }
+const vector<Process>& MLFQ_Scheduler::getFinishedProcesses() const { return finishedProcesses; }
+const MetricsAccumulator& MLFQ_Scheduler::getMetrics() const { return metrics; }
\ No newline at end of file
@@ -4,57 +4,155 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <cstdio>
+#include <memory>
+#include <functional>
 
 using namespace std;
 
+// Tiempo simulado (reloj, AT, BT y metricas por proceso). Por defecto int;
+// compilando con -DMLFQ_TIME64 es de 64 bits, para trazas cuyo reloj pasa
+// de 2^31 unidades. Los .out y las metricas no cambian; los checkpoints
+// guardan siempre 64 bits.
+#ifdef MLFQ_TIME64
+typedef long long SimTime;
+#else
+typedef int SimTime;
+#endif
+
+// Lectura y escritura de checkpoints (mt01_checkpoint.cpp)
+class SnapshotWriter;
+class SnapshotReader;
+
 // Enum para los diferentes algoritmos de planificacion
 enum SchedulingAlgorithm {
     ROUND_ROBIN,
     SJF,
-    STCF
+    STCF,
+    PRIORITY,              // Prioridad estricta por Pr, RR entre iguales
+    STRIDE,                // Stride scheduling con tickets = Pr
+    LOTTERY                // Sorteo con tickets = Pr
+};
+
+// Valores de Pr que usan las politicas por prioridad (fuera de rango se acotan)
+const int PRIORITY_LEVELS = 5;
+
+// RR, PRIORITY, STRIDE y LOTTERY ejecutan por quantums
+bool algorithmUsesQuantum(SchedulingAlgorithm algorithm);
+
+// Configuracion de un nivel de cola: algoritmo y quantum (RR, PRIORITY,
+// STRIDE y LOTTERY)
+struct QueueConfig {
+    SchedulingAlgorithm algorithm;
+    int quantum;
+    
+    QueueConfig(SchedulingAlgorithm alg = ROUND_ROBIN, int q = 0) : algorithm(alg), quantum(q) {}
+};
+
+// Reglas de retroalimentacion entre niveles. Por defecto ninguna: cada
+// proceso se queda en la cola por la que llego, como en los esquemas
+// originales.
+struct FeedbackConfig {
+    bool demoteOnExpiry;   // RR: al agotar el quantum baja al nivel siguiente
+    SimTime boostPeriod;   // Cada S ticks todos suben al primer nivel (0 = nunca)
+    
+    FeedbackConfig(bool demote = false, SimTime boost = 0) : demoteOnExpiry(demote), boostPeriod(boost) {}
+};
+
+// Texto sin espacios ni tabuladores al principio y al final
+string trimSpaces(const string& text);
+
+// Entero escrito completo, sin espacios ni texto extra ("2x" o "3 " no son
+// numeros validos)
+bool parseIntText(const string& text, int& value);
+bool parseIntText(const string& text, long long& value);
+
+// Texto <-> reglas: "off", "demote", "boost=S" o "demote,boost=S"
+bool parseFeedback(const string& text, FeedbackConfig& feedback);
+string describeFeedback(const FeedbackConfig& feedback);
+
+// Niveles de los esquemas predefinidos 1, 2 y 3
+vector<QueueConfig> schemeLevels(int scheme);
+
+// Texto <-> niveles, por ejemplo "RR(2),RR(3),RR(4),STCF" o
+// "PRIO(2),STRIDE(4),LOTTERY(4),STCF"
+bool parseLevels(const string& text, vector<QueueConfig>& levels);
+string describeLevels(const vector<QueueConfig>& levels);
+
+// Tabla global de etiquetas: cada texto distinto se guarda una sola vez y
+// los procesos llevan solo su id. intern() es seguro entre hilos; name() no
+// toma lock porque una etiqueta ya guardada nunca se mueve. release() quita
+// la referencia de un intern(); sin referencias el id queda libre (solo se
+// usa en el modo en linea, donde cada proceso se descarta al terminar).
+class LabelTable {
+public:
+    static int intern(string_view text);
+    static void internAll(const vector<string_view>& texts, vector<int>& ids);
+    static void release(int id);
+    static const string& name(int id);
+    static int size();
 };
 
-// Clase para representar un proceso
+// Tabla global de secuencias de rafagas "C5,I20,C3" (CPU y E/S alternadas,
+// empezando y terminando en CPU). Un proceso con E/S lleva el id de su
+// secuencia; sin E/S el id es -1 y no ocupa lugar. Como LabelTable: add() y
+// release() toman lock, bursts() no (una secuencia guardada no se mueve).
+class BurstTable {
+public:
+    static int add(const vector<int>& bursts);
+    static void release(int id);
+    static const vector<int>& bursts(int id);
+};
+
+// Lee "C5,I20,C3" (mayusculas o minusculas, duraciones >= 1). Devuelve
+// false si no alterna CPU y E/S empezando y terminando en CPU.
+bool parseBurstList(const char* first, const char* last, vector<int>& bursts);
+string describeBurstList(const vector<int>& bursts);
+
+// Clase para representar un proceso (datos de entrada y metricas finales;
+// el estado que cambia en cada tick vive en el scheduler, ver RunState)
 class Process {
 private:
-    string label;           // Etiqueta del proceso
-    int burstTime;         // Tiempo de CPU requerido
-    int arrivalTime;       // Tiempo de llegada
-    int queueLevel;        // Nivel de cola (1, 2, 3)
-    int priority;          // Prioridad (5 más alta, 1 más baja)
-    int waitingTime;       // Tiempo de espera
-    int completionTime;    // Tiempo de finalizacion
-    int responseTime;      // Tiempo de respuesta
-    int turnaroundTime;    // Tiempo de retorno
-    int remainingTime;     // Tiempo restante para completar
-    bool hasStarted;       // Si el proceso ya empezo a ejecutarse
+    int labelId;             // Etiqueta del proceso (id en LabelTable)
+    SimTime burstTime;       // Tiempo de CPU requerido
+    SimTime arrivalTime;     // Tiempo de llegada
+    int queueLevel;          // Nivel de cola (1, 2, 3)
+    int priority;            // Prioridad (5 más alta, 1 más baja)
+    SimTime waitingTime;     // Tiempo de espera
+    SimTime completionTime;  // Tiempo de finalizacion
+    SimTime responseTime;    // Tiempo de respuesta
+    SimTime turnaroundTime;  // Tiempo de retorno
+    SimTime ioTime;          // E/S total de la secuencia de rafagas
+    int burstsId;            // Secuencia en BurstTable (-1 = una sola rafaga de CPU)
 
 public:
     // Constructor
-    Process(string lbl, int bt, int at, int q, int pr);
+    Process(const string& lbl, SimTime bt, SimTime at, int q, int pr);
+    Process(int lblId, SimTime bt, SimTime at, int q, int pr);
     
     // Getters
-    string getLabel() const;
-    int getBurstTime() const;
-    int getArrivalTime() const;
+    const string& getLabel() const;
+    int getLabelId() const;
+    SimTime getBurstTime() const;
+    SimTime getArrivalTime() const;
     int getQueueLevel() const;
     int getPriority() const;
-    int getWaitingTime() const;
-    int getCompletionTime() const;
-    int getResponseTime() const;
-    int getTurnaroundTime() const;
-    int getRemainingTime() const;
-    bool getHasStarted() const;
+    SimTime getWaitingTime() const;
+    SimTime getCompletionTime() const;
+    SimTime getResponseTime() const;
+    SimTime getTurnaroundTime() const;
+    SimTime getIoTime() const;
+    int getBurstsId() const;
+    bool hasIo() const;
     
     // Setters
-    void setWaitingTime(int wt);
-    void setCompletionTime(int ct);
-    void setResponseTime(int rt);
-    void setTurnaroundTime(int tat);
-    void setRemainingTime(int rt);
-    void setHasStarted(bool started);
+    void setWaitingTime(SimTime wt);
+    void setCompletionTime(SimTime ct);
+    void setResponseTime(SimTime rt);
+    void setTurnaroundTime(SimTime tat);
+    void setBursts(int id);   // BT pasa a ser la CPU total de la secuencia
     
     // Metodos utilitarios
     void calculateMetrics();
@@ -62,61 +160,648 @@ public:
 };
 
 
-// Clase para manejar una cola con algoritmo especifico
-class ProcessQueue {
+// Histograma logaritmico de latencias: exacto hasta 63 y con error relativo
+// menor a 1/32 por encima. Tamano fijo y combinable (merge) entre corridas.
+class LatencyHistogram {
+private:
+    vector<long long> buckets;
+    long long total;
+    long long minValue;
+    long long maxValue;
+    
+    static int bucketOf(long long value);
+    static long long bucketUpperBound(int bucket);
+    
 public:
-    vector<Process> processes;
+    LatencyHistogram();
+    
+    void record(long long value);
+    void record(long long value, long long weight);  // 'weight' veces el valor
+    void merge(const LatencyHistogram& other);
+    long long percentile(double p) const;
+    long long count() const;
+    long long getMin() const;
+    long long getMax() const;
+    void save(SnapshotWriter& out) const;
+    bool load(SnapshotReader& in);
+};
+
+// Sumas y distribuciones de WT, CT, RT y TAT de un conjunto de procesos.
+// WT es solo la espera en las colas: el tiempo bloqueado en E/S va aparte.
+struct MetricsSummary {
+    long long count;
+    long long totalWT;
+    long long totalCT;
+    long long totalRT;
+    long long totalTAT;
+    long long totalIO;
+    LatencyHistogram waiting;
+    LatencyHistogram response;
+    LatencyHistogram turnaround;
     
+    MetricsSummary();
+    void record(const Process& p);
+    void record(long long wt, long long ct, long long rt, long long tat, long long io = 0);
+    void merge(const MetricsSummary& other);
+    double averageWT() const;
+    double averageCT() const;
+    double averageRT() const;
+    double averageTAT() const;
+    double averageIO() const;
+    void save(SnapshotWriter& out) const;
+    bool load(SnapshotReader& in);
+};
+
+// Metricas en linea: se actualizan una vez al terminar cada proceso, sin
+// necesidad de conservar los procesos terminados. Global y por cola.
+class MetricsAccumulator {
+private:
+    MetricsSummary overall;
+    vector<MetricsSummary> perLevel;
+    
+public:
+    MetricsAccumulator(int levels = 0);
+    
+    void record(const Process& p, int level);
+    void record(long long wt, long long ct, long long rt, long long tat, int level);
+    void merge(const MetricsAccumulator& other);
+    const MetricsSummary& getOverall() const;
+    const MetricsSummary& getLevel(int level) const;
+    int levels() const;
+    void printPercentiles() const;
+    void save(SnapshotWriter& out) const;
+    bool load(SnapshotReader& in);
+};
+
+// Error de formato encontrado al leer un archivo de procesos
+struct LoadError {
+    long long line;        // Numero de linea (desde 1)
+    string message;
+};
+
+// Lee un archivo "etiqueta;BT;AT;Q;Pr" mapeado en memoria, en el orden del
+// archivo. Los archivos grandes se parten en bloques que se parsean en
+// 'threads' hilos (0 = todos los nucleos). Devuelve false si no se pudo abrir.
+bool parseProcessFile(const string& filename, vector<Process>& processes,
+                      vector<LoadError>& errors, int threads = 0);
+
+// Una linea de entrada: proceso valido, vacia/comentario o con error
+enum LineParse {
+    LINE_EMPTY,
+    LINE_PROCESS,
+    LINE_INVALID
+};
+
+// Parsea una sola linea; con LINE_PROCESS agrega el proceso a 'processes' y
+// con LINE_INVALID deja el motivo en 'error'
+LineParse parseProcessLine(string_view line, vector<Process>& processes, string& error);
+
+// parseProcessFile para un scheduler: informa los errores por consola y
+// lista cada proceso si 'echo'
+bool loadProcessList(const string& filename, int threads, bool echo, vector<Process>& loaded);
+
+// Salida comun de los schedulers: archivo .out, tabla y promedios. Las
+// partes del .out sirven tambien para escribirlo a medida que terminan.
+void writeResultsHeader(FILE* file);
+void writeResultLine(FILE* file, const Process& p);
+void writeAveragesLine(FILE* file, const MetricsAccumulator& metrics);
+void writeResults(FILE* file, const vector<Process>& finished, const MetricsAccumulator& metrics,
+                  int threads = 0);
+bool writeResultsFile(const string& filename, const vector<Process>& finished,
+                      const MetricsAccumulator& metrics);
+void printResultsTable(const vector<Process>& finished, const MetricsAccumulator& metrics);
+
+// Formato rapido (mt01_results.cpp): las lineas se arman con to_chars en
+// bloques, en 'threads' hilos (0 = todos), y se escriben en orden
+void appendResultLine(string& out, const Process& p);
+void writeResultLines(FILE* file, const vector<Process>& finished, int threads);
+
+// Archivo binario por columnas (un SimTime por proceso y metrica, en el
+// orden del .out) con un diccionario de etiquetas; se puede mapear a memoria
+bool writeResultColumns(const string& filename, const vector<Process>& finished);
+void printAverages(const MetricsAccumulator& metrics);
+
+// Niveles de detalle del timeline de la simulacion
+enum TimelineLevel {
+    TIMELINE_OFF,          // Nada
+    TIMELINE_SUMMARY,      // Solo inicio y fin de la simulacion
+    TIMELINE_DECISIONS,    // Un intervalo "t0-t1: X" por tramo continuo de un proceso
+    TIMELINE_TICKS         // Una linea por ejecucion (por tick en el motor por ticks)
+};
+
+bool parseTimelineLevel(const string& name, TimelineLevel& lvl);
+
+// Destino del timeline: acumula en un buffer grande y escribe con fwrite,
+// sin vaciar en cada linea. Por defecto escribe en stdout.
+class TimelineSink {
+private:
+    TimelineLevel level;
+    FILE* out;
+    bool ownsFile;
+    vector<char> buffer;
+    size_t used;
+    
+    // Intervalo pendiente de escribir (nivel DECISIONS)
+    const Process* pending;
+    SimTime pendingStart;
+    SimTime pendingEnd;
+    
+    void appendText(const char* text, size_t length);
+    void appendText(const string& text);
+    void appendInt(long long value);
+    void flushPending();
+    void writeBuffer();
+    
+public:
+    TimelineSink(TimelineLevel lvl = TIMELINE_TICKS, FILE* output = stdout);
+    ~TimelineSink();
+    TimelineSink(const TimelineSink&) = delete;
+    TimelineSink& operator=(const TimelineSink&) = delete;
+    
+    bool openFile(const string& filename);
+    void setLevel(TimelineLevel lvl);
+    TimelineLevel getLevel() const;
+    
+    void summary(const string& text);
+    void run(const Process& p, SimTime start, SimTime timeSlice);
+    void flush();
+};
+
+// Carga de trabajo inmutable: se lee una vez y se comparte (solo lectura)
+// entre varias simulaciones, con el orden de llegada ya calculado
+class ProcessTrace {
+private:
+    vector<Process> processes;     // En el orden del archivo
+    vector<int> arrivalOrder;      // Indices ordenados por AT (estable)
+    
+public:
+    bool loadFromFile(const string& filename, vector<LoadError>& errors, int threads = 0);
+    void addProcess(const Process& p);
+    void finalize();
+    
+    const vector<Process>& getProcesses() const;
+    const vector<int>& getArrivalOrder() const;
+    int size() const;
+    bool hasIo() const;            // Algun proceso con rafagas de E/S
+};
+
+// Hilos a usar: 'threads' o, si es 0, todos los nucleos
+int resolveThreadCount(int threads);
+
+// Ejecuta task(i) para cada i en [0, count) repartido en 'threads' hilos
+void parallelFor(int count, int threads, const function<void(int)>& task);
+
+// Enlaces intrusivos de un proceso dentro de la cola en la que esta.
+// Hay uno por proceso (paralelo al almacen del scheduler), porque un proceso
+// esta como mucho en una cola a la vez.
+struct QueueLink {
+    int prev;              // RR/PRIORITY: anterior en la lista (-1 si es la cabeza)
+    int next;              // RR/PRIORITY: siguiente en la lista (-1 si es la cola)
+    int heapPos;           // SJF/STCF/STRIDE: posicion en el monticulo; LOTTERY: lugar en el sorteo
+    SimTime key;           // Tiempo restante actual
+    long long sortKey;     // SJF/STCF: restante del ultimo ordenamiento; STRIDE: pass de ese momento
+    long long stamp;       // RR: orden de insercion; SJF/STCF/STRIDE: desempate
+    long long pass;        // STRIDE: CPU usada en este nivel, ponderada por 1/tickets
+    int segment;           // RR: tramo de sellos (ver ProcessQueue::appendAll)
+    unsigned char weight;  // Pr acotada a 1..PRIORITY_LEVELS (nivel o tickets)
+    bool dirty;            // SJF/STCF/STRIDE: la clave cambio y falta reordenar
+};
+
+// Enlace de un proceso que todavia no esta en ninguna cola
+QueueLink makeQueueLink(const Process& p);
+
+// Estado caliente de un proceso durante la simulacion, paralelo al almacen
+// del scheduler. Las metricas (frias) quedan en Process y solo se escriben al
+// entrar por primera vez a CPU y al terminar. Ocupa 16 bytes, o 24 con
+// MLFQ_TIME64 (los dos tiempos pasan a 64 bits).
+struct RunState {
+    SimTime remaining;     // Tiempo restante de la rafaga de CPU actual
+    SimTime arrival;       // Copia de AT
+    int level;             // Cola de llegada (0-based, ya acotada); bloqueado: cola a la que vuelve
+    int started;           // Si el proceso ya empezo a ejecutarse
+};
+
+// Estado inicial de un proceso que llega a la cola 'level'
+RunState makeRunState(const Process& p, int level);
+
+// Clase para manejar una cola con algoritmo especifico.
+// Guarda handles (indices en el almacen de procesos del scheduler), no copias.
+class ProcessQueue {
 private:
     SchedulingAlgorithm algorithm;
     int quantum;           // Para Round Robin
-    int currentIndex;      // Para Round Robin
+    int cursor;            // Para Round Robin: proceso en turno (-1 = cabeza)
+    vector<QueueLink>* links;
+    long long nextStamp;
+    int count;
+    
+    // Round Robin: lista doblemente enlazada intrusiva. El orden en la lista
+    // es el de los sellos efectivos (desplazamiento del tramo + sello), asi
+    // una lista empalmada al final queda detras sin renumerar sus nodos.
+    int head;
+    int tail;
+    vector<long long>* stampOffsets;  // Desplazamiento de cada tramo (compartido)
+    int segment;                      // Tramo de las inserciones nuevas
+    vector<int> ownedSegments;        // Tramos con nodos en esta lista
+    
+    // SJF/STCF: monticulo indexado. El orden es (tiempo restante al ultimo
+    // reordenamiento, sello), que reproduce el ordenamiento estable por
+    // tiempo restante de siempre. STRIDE usa el mismo monticulo con el pass
+    // como clave. Las claves se copian en arreglos paralelos al monticulo
+    // para que subir y bajar compare memoria contigua en vez de saltar a los
+    // enlaces de cada proceso (que siguen siendo la copia que se guarda).
+    vector<int> heap;      // handles en forma de monticulo
+    vector<long long> heapKeys;    // sortKey de heap[i]
+    vector<long long> heapStamps;  // stamp de heap[i]
+    vector<int> dirty;     // handles cuyo restante cambio desde entonces
+    long long basePass;    // STRIDE: pass del ultimo elegido (para llegar a una cola vacia)
+    
+    // PRIORITY: una lista por valor de Pr (indice Pr - 1) con los enlaces
+    // prev/next; se elige la cabeza de la lista mas alta no vacia
+    vector<int> bucketHead;
+    vector<int> bucketTail;
+    
+    // LOTTERY: procesos en un arreglo denso (heapPos = lugar) y un arbol de
+    // Fenwick con sus tickets, para sortear y quitar en O(log n)
+    vector<int> slots;
+    vector<long long> tickets;     // Fenwick 1-based (tickets[0] sin uso)
+    long long totalTickets;
+    unsigned long long randomState;  // splitmix64
+    
+    bool isHeapOrdered() const;
+    long long orderKey(const QueueLink& link) const;
+    void addTickets(int slot, long long delta);
+    long long ticketPrefix(int slots) const;
+    unsigned long long nextRandom();
+    void collectInOrder(vector<int>& order);
+    void appendToHeap(ProcessQueue& other);
+    bool heapLess(int a, int b) const;
+    void heapStore(int i, int handle, long long key, long long stamp);
+    void rebuildHeapKeys();
+    void siftUp(int i);
+    void siftDown(int i);
+    void reorder();
+    void newSegment();
+    long long stampOf(int handle) const;
     
 public:
     // Constructor
     ProcessQueue(SchedulingAlgorithm alg, int q = 0);
+    void bindLinks(vector<QueueLink>* queueLinks, vector<long long>* offsets);
     
     // Métodos principales
-    void addProcess(Process p);
-    Process getNextProcess(int currentTime);
+    void addProcess(int handle, SimTime remaining);
+    int getNextProcess(SimTime currentTime);
     bool isEmpty() const;
     int size() const;
-    void removeProcess(Process p);
+    void removeProcess(int handle);
+    void updateRemaining(int handle, SimTime remaining);
+    void reserve(int processes);
+    void appendAll(ProcessQueue& other);
+    int lastProcess(int exclude) const;
+    void rotate(int handle, SimTime remaining);
     
     // Métodos específicos para algoritmos
-    Process roundRobin(int currentTime);
-    Process shortestJobFirst(int currentTime);
-    Process shortestTimeToCompletion(int currentTime);
+    int roundRobin(SimTime currentTime);
+    int shortestJobFirst(SimTime currentTime);
+    int shortestTimeToCompletion(SimTime currentTime);
+    int strictPriority(SimTime currentTime);
+    int strideScheduling(SimTime currentTime);
+    int lottery(SimTime currentTime);
     
-    // Getters
+    // Getters y setters
     int getQuantum() const;
+    void setQuantum(int q);
+    void setSeed(unsigned long long seed);
     SchedulingAlgorithm getAlgorithm() const;
+    bool usesQuantum() const;      // RR, PRIORITY, STRIDE, LOTTERY
+    bool preemptsWithin() const;   // STCF y PRIORITY re-eligen en cada decision
+    
+    // Checkpoint (sin los punteros compartidos, que vuelve a atar el scheduler)
+    void save(SnapshotWriter& out) const;
+    bool load(SnapshotReader& in, int handles);
+};
+
+// ---- Instrumentacion ----
+
+// Cronometros de las partes calientes del bucle
+enum StatTimer {
+    TIMER_ARRIVALS,        // checkArrivals() y despertares de E/S
+    TIMER_SELECTION,       // Boost, preempciones y eleccion del proximo proceso
+    TIMER_UPDATE,          // updateProcessInQueue()
+    TIMER_COUNT
+};
+
+// Contadores de lo que hace el scheduler. Los tiempos simulados (ocupacion
+// de colas, CPU por nivel, ticks ociosos) no dependen del motor; los
+// cronometros miden tiempo real. Apagada, el bucle es el mismo de siempre
+// (advanceWith<false>) y solo se paga un if por iteracion; compilando con
+// -DMLFQ_NO_STATS ni eso.
+struct SchedulerStats {
+    long long contextSwitches;      // Despachos de un proceso distinto al anterior
+    long long arrivalPreemptions;   // Desalojos por llegada a un nivel superior
+    long long stcfPreemptions;      // Cambios por uno mas corto dentro de STCF
+    long long priorityPreemptions;  // Cambios por uno de mayor Pr dentro de PRIORITY
+    long long rrRotations;          // Quantums agotados (rotacion o democion)
+    long long demotions;            // De esos, los que bajaron de nivel
+    long long boosts;
+    long long ioBlocks;             // Rafagas de CPU que terminaron en E/S
+    long long idleTicks;            // Unidades sin proceso en CPU
+    vector<long long> busyTime;     // Unidades de CPU por nivel
+    vector<LatencyHistogram> depth; // Procesos en cada cola, ponderado por tiempo
+    vector<long long> depthArea;    // Suma de procesos * tiempo por nivel
+    long long timerNanos[TIMER_COUNT];
+    long long timerCalls[TIMER_COUNT];
+    int lastHandle;                 // Ultimo proceso despachado (-1 = ninguno)
+    
+    SchedulerStats(int levels = 0);
+    void recordRun(const vector<ProcessQueue>& queues, int handle, int level, SimTime duration);
+    void recordIdle(SimTime duration);
+    bool writeJson(const string& filename, const vector<QueueConfig>& levels, bool eventDriven,
+                   SimTime makespan, long long dispatches) const;
+};
+
+// ---- Procesos bloqueados en E/S ----
+
+// Rueda de temporizadores jerarquica: WHEEL_LEVELS niveles de 64 casillas,
+// la casilla del nivel k abarca 64^k unidades. Un proceso entra al nivel del
+// bit mas alto en que su despertar difiere del reloj de la rueda (O(1)) y
+// baja de nivel cuando el reloj llega a su casilla, a lo sumo una vez por
+// nivel. Cada nivel tiene un mapa de bits de casillas ocupadas, asi que
+// avanzar sobre un hueco largo salta directo a la proxima casilla con algo.
+// Los que despiertan juntos salen en el orden en que se bloquearon.
+class TimerWheel {
+public:
+    static const int LEVEL_BITS = 6;
+    static const int SLOTS = 1 << LEVEL_BITS;
+    static const int WHEEL_LEVELS = sizeof(SimTime) * 8 / LEVEL_BITS + 1;  // Cubre cualquier SimTime
+    
+private:
+    SimTime now;                               // Todo lo pendiente despierta despues
+    int count;
+    long long nextOrder;
+    unsigned long long occupied[WHEEL_LEVELS];
+    vector<int> slotHead;                      // WHEEL_LEVELS * SLOTS listas
+    vector<int> slotTail;
+    vector<int> next;                          // Por handle: siguiente en su casilla
+    vector<SimTime> when;                      // Por handle: tiempo de despertar
+    vector<long long> order;                   // Por handle: orden de bloqueo
+    mutable SimTime cachedWake;                // nextWake() ya calculado (-2 = no)
+    
+    void place(int handle);
+    void takeSlot(int level, int slot, vector<int>& woken);
+    
+public:
+    TimerWheel();
+    
+    void resize(int handles);
+    void schedule(int handle, SimTime time);   // time > getNow()
+    void advance(SimTime time, vector<int>& woken); // Agrega a 'woken' los que despiertan hasta 'time'
+    SimTime nextWake() const;                  // -1 si no hay bloqueados
+    int size() const;
+    SimTime getNow() const;
+    SimTime wakeTime(int handle) const;
+    
+    void save(SnapshotWriter& out) const;
+    bool load(SnapshotReader& in, int handles);
 };
 
+// ---- Traza binaria de intervalos ----
+
+// Por que un proceso deja la CPU (cierra su intervalo en la traza)
+enum IntervalReason {
+    END_FINISH,            // Termino
+    END_QUANTUM,           // Agoto el quantum y roto en su nivel
+    END_DEMOTE,            // Agoto el quantum y bajo de nivel
+    END_ARRIVAL,           // Llego trabajo a un nivel superior
+    END_PREEMPT,           // STCF/PRIO: otro de su nivel paso adelante
+    END_BOOST,             // Boost periodico
+    END_IO,                // Se bloqueo en E/S
+    END_CUT                // Corte sin decision (fin de la traza)
+};
+
+const char* describeIntervalReason(IntervalReason reason);
+
+// Un tramo continuo de CPU de un proceso en un nivel. 'pid' numera los
+// procesos en el orden en que entran por primera vez a CPU.
+struct TraceInterval {
+    long long start;
+    long long end;
+    int pid;
+    int level;
+    IntervalReason reason;
+};
+
+// Posicion y rango de tiempo de un bloque de la traza
+struct TraceBlockInfo {
+    long long offset;
+    long long start;                   // Inicio del primer intervalo
+    long long end;                     // Fin del ultimo intervalo
+    int count;                         // Intervalos
+    int bytes;
+};
+
+// Escribe la traza: los ticks seguidos del mismo proceso y nivel se juntan
+// en un intervalo y los intervalos se codifican con varints (deltas) en
+// bloques de TRACE_BLOCK_INTERVALS. Al cerrar se agrega un indice con el
+// rango de tiempo de cada bloque y, por proceso, su etiqueta y el primer y
+// ultimo bloque en que aparece.
+class IntervalTraceWriter {
+private:
+    FILE* out;
+    bool failed;
+    vector<string> levelNames;         // "RR(2)", "STCF", ...
+    vector<unsigned char> block;       // Bloque en curso, codificado
+    TraceBlockInfo current;
+    long long previousEnd;
+    int previousPid;
+    vector<TraceBlockInfo> index;
+    vector<string> labels;             // Por pid
+    vector<int> firstBlock;            // Por pid
+    vector<int> lastBlock;
+    vector<long long> cpuTime;
+    vector<int> pidOfHandle;           // -1 = sin pid (o ya termino)
+    long long intervals;
+
+    // Intervalo abierto (se extiende mientras siga el mismo proceso)
+    bool open;
+    int openHandle;
+    int openLevel;
+    long long openStart;
+    long long openEnd;
+
+    void raw(const void* data, size_t size);
+    void emit(IntervalReason reason);
+    void flushBlock();
+
+public:
+    IntervalTraceWriter();
+    ~IntervalTraceWriter();
+    IntervalTraceWriter(const IntervalTraceWriter&) = delete;
+    IntervalTraceWriter& operator=(const IntervalTraceWriter&) = delete;
+
+    bool create(const string& filename, const vector<QueueConfig>& levels);
+    void run(const Process& p, int handle, int level, long long start, SimTime timeSlice);
+    void stop(IntervalReason reason);
+    bool close();                      // Escribe el indice; false si hubo error
+    long long getIntervals() const;
+};
+
+// Lee una traza: el indice se carga al abrir y los bloques se leen y
+// decodifican solo cuando una consulta los necesita.
+class IntervalTraceReader {
+private:
+    FILE* file;
+    long long fileBytes;
+    vector<string> levelNames;
+    vector<TraceBlockInfo> index;
+    vector<string> labels;
+    vector<int> firstBlock;
+    vector<int> lastBlock;
+    vector<long long> cpuTime;
+
+public:
+    IntervalTraceReader();
+    ~IntervalTraceReader();
+    IntervalTraceReader(const IntervalTraceReader&) = delete;
+    IntervalTraceReader& operator=(const IntervalTraceReader&) = delete;
+
+    bool open(const string& filename, string& error);
+    bool readBlock(int b, vector<TraceInterval>& out) const;
+    int findBlock(long long time) const;           // Ultimo bloque que empieza en o antes de 'time'
+    int firstBlockEndingAfter(long long time) const;
+
+    int getLevels() const;
+    const string& getLevelName(int level) const;
+    int getBlocks() const;
+    long long getFileBytes() const;
+    long long getIntervals() const;
+    long long getStart() const;
+    long long getEnd() const;
+    int getProcesses() const;
+    const string& getLabel(int pid) const;
+    int getFirstBlock(int pid) const;
+    int getLastBlock(int pid) const;
+    long long getCpuTime(int pid) const;
+    const TraceBlockInfo& getBlock(int b) const;
+};
+
+// Consulta sobre una traza (--trace-query): sin opciones, un resumen
+struct TraceQuery {
+    long long at;                      // Que corria en 'at' (-1 = no)
+    string label;                      // Intervalos de los procesos con esa etiqueta
+    long long from, to;                // Ventana [from, to) (from < 0 = no)
+    string chromeFile;                 // Exportar la ventana en JSON de Chrome
+
+    TraceQuery() : at(-1), from(-1), to(-1) {}
+};
+
+bool parseTraceWindow(const string& text, long long& from, long long& to);
+bool runTraceQuery(const string& filename, const TraceQuery& query);
+
 // Clase principal del scheduler MLFQ
 class MLFQ_Scheduler {
 private:
+    vector<QueueConfig> levelConfig;
     vector<ProcessQueue> queues;
-    vector<Process> allProcesses;
-    vector<Process> finishedProcesses;
-    int currentTime;
+    vector<Process> allProcesses;       // Almacen estable: el handle es el indice
+    vector<RunState> runStates;         // Estado caliente, paralelo a allProcesses
+    vector<QueueLink> queueLinks;       // Enlaces de cola, paralelo a allProcesses
+    vector<long long> stampOffsets;     // Tramos de sellos de las listas RR
+    FeedbackConfig feedback;
+    vector<int> pendingArrivals;        // Handles por llegar, ordenados por AT
+    int arrivalCursor;                  // Primer handle de pendingArrivals sin llegar
+    bool arrivalsSorted;                // false si se agregaron procesos sin ordenar
+    vector<Process> finishedProcesses;  // Solo si retainFinished
+    MetricsAccumulator metrics;
+    SimTime currentTime;
+    long long executedSlices; // Llamadas a executeProcess (decisiones de despacho)
     int scheme; // 1, 2, o 3 para los diferentes esquemas
+    bool eventDriven; // true: salta al siguiente evento en vez de avanzar tick a tick
+    bool echoOnLoad;  // imprimir cada proceso al cargarlo
+    int loadThreads;  // hilos para parsear la entrada (0 = todos los nucleos)
+    shared_ptr<TimelineSink> timeline;
+    bool retainFinished; // guardar cada proceso terminado (para el .out y la tabla)
+    
+    // Estado del bucle; se conserva entre llamadas a step() y runUntil()
+    bool hasRunning;
+    int running;         // handle del proceso en CPU
+    int runningQueue;
+    int rrQuantumUsed;   // unidades usadas del quantum en RR
+    SimTime nextBoost;   // proximo boost (-1 = sin boost)
+    vector<int> freeHandles;  // Handles de procesos terminados, para submit()
+    function<void(const Process&)> onComplete;
+    string checkpointFile;    // Checkpoints periodicos en simulate() ("{t}" = tiempo)
+    SimTime checkpointEvery;  // Cada cuantas unidades de tiempo (0 = nunca)
+    bool instrumented;        // Llevar SchedulerStats (ver setInstrumentation)
+    SchedulerStats stats;
+    unsigned long long randomSeed;  // Semilla de los sorteos (LOTTERY)
+    
+    // Rafagas de E/S: bloqueados en la rueda, rafaga actual de cada proceso
+    // (indice en su secuencia, paralelo al almacen) y CPU ocupada
+    TimerWheel blocked;
+    vector<int> burstIndex;
+    vector<int> woken;        // Despertados en este tiempo (reservado)
+    long long busyTime;
+    SimTime lastBoost;        // Tiempo del ultimo boost (-1 = ninguno)
+    shared_ptr<IntervalTraceWriter> intervals;  // Traza binaria (null = sin traza)
+    
+    void initQueues(const vector<QueueConfig>& levels);
+    void rebindQueues();
+    unsigned long long levelSeed(int level) const;
+    void sortPendingArrivals();
+    int levelOf(const Process& p) const;
+    void boostAll();
+    void advance(SimTime horizon);
+    template <bool Stats> void advanceWith(SimTime horizon);
+    template <bool Stats> void updateWith(int queueIndex, int handle);
+    bool blockForIo(int handle);
+    void checkWakeups();
+    SimTime nextEventTime() const;
     
 public:
-    // Constructor
+    // Constructores
     MLFQ_Scheduler(int schemeNumber);
+    MLFQ_Scheduler(const vector<QueueConfig>& levels);
+    
+    // Copia (las colas apuntan a los enlaces de su propio scheduler)
+    MLFQ_Scheduler(const MLFQ_Scheduler& other);
+    MLFQ_Scheduler& operator=(const MLFQ_Scheduler& other);
     
     // Destructor
     ~MLFQ_Scheduler();
     
     // Metodos principales
-    void addProcess(Process p);
+    int addProcess(const Process& p);
+    void prepareRun();
     void simulate();
-    void executeProcess(Process& p, int timeSlice);
+    
+    // API por pasos: los procesos pueden llegar mientras corre la simulacion.
+    // submit() reutiliza el lugar de los procesos ya terminados, asi que la
+    // memoria depende de los procesos vivos y no del total.
+    int submit(const Process& p);
+    bool hasWork() const;
+    bool step();            // Una decision (un tick o un evento); false si no hay trabajo
+    void runUntil(SimTime time); // Avanza el reloj hasta 'time' sin pasarse
+    void drain();           // Corre hasta que no quede trabajo
+    void setCompletionCallback(const function<void(const Process&)>& callback);
+    
+    // Checkpoint binario del estado completo de la simulacion y copias en
+    // memoria para seguir desde el mismo punto con otra configuracion
+    bool saveCheckpoint(const string& filename) const;
+    void setCheckpointInterval(const string& filename, SimTime every);
+    bool loadCheckpoint(const string& filename);
+    MLFQ_Scheduler fork() const;
+    bool setLevels(const vector<QueueConfig>& levels);
+    const vector<QueueConfig>& getLevels() const;
+    void executeProcess(int handle, SimTime timeSlice);
     void checkArrivals();
+    SimTime nextArrivalTime() const;
     
     // Metodos de entrada/salida
     bool loadProcessesFromFile(const string& filename);
+    void loadTrace(const ProcessTrace& trace);
+    void loadTracePrefix(const ProcessTrace& trace, int count);
     void saveResultsToFile(const string& filename);
     
     // Metodos de calculo
@@ -124,11 +809,298 @@ public:
     void printResults();
     
     // Metodo auxiliar
-    void updateProcessInQueue(int queueIndex, const Process& updatedProcess);
+    void updateProcessInQueue(int queueIndex, int handle);
+    
+    // Configuracion del motor
+    void setEventDriven(bool enabled);
+    bool isEventDriven() const;
+    void setLoadEcho(bool enabled);
+    void setLoadThreads(int threads);
+    void setTimeline(shared_ptr<TimelineSink> sink);
+    void setIntervalTrace(shared_ptr<IntervalTraceWriter> writer);
+    void setRetainFinished(bool enabled);
+    void setFeedback(const FeedbackConfig& rules);
+    const FeedbackConfig& getFeedback() const;
+    void setRandomSeed(unsigned long long seed);
+    
+    // Instrumentacion: al activarla los contadores empiezan de cero
+    void setInstrumentation(bool enabled);
+    bool isInstrumented() const;
+    const SchedulerStats& getStats() const;
+    bool saveStats(const string& filename) const;
     
     // Getters
-    int getCurrentTime() const;
-    vector<Process> getFinishedProcesses() const;
+    SimTime getCurrentTime() const;
+    long long getExecutedSlices() const;
+    long long getBusyTime() const;
+    int getBlockedCount() const;
+    const vector<Process>& getFinishedProcesses() const;
+    const MetricsAccumulator& getMetrics() const;
 };
 
+// ---- Modo en linea ----
+
+// Lee procesos "etiqueta;BT;AT;Q;Pr" de 'in' (stdin o un FIFO) mientras la
+// simulacion avanza y escribe en 'out' cada proceso al terminar, con memoria
+// acotada por los procesos vivos. Al final escribe la linea de promedios.
+bool runProcessStream(istream& in, FILE* out, MLFQ_Scheduler& scheduler);
+
+// ---- Multiples CPUs ----
+
+// CPU a la que va cada proceso que llega
+enum PlacementPolicy {
+    PLACE_HASH,            // Hash de la etiqueta
+    PLACE_LEAST_LOADED,    // La de menos trabajo restante
+    PLACE_ROUND_ROBIN      // Una tras otra
+};
+
+bool parsePlacement(const string& name, PlacementPolicy& policy);
+
+// Una CPU: sus propias colas por nivel y el proceso que esta ejecutando.
+// Los procesos asignados siguen en el almacen comun del scheduler.
+struct CoreState {
+    vector<ProcessQueue> queues;
+    bool hasRunning;
+    int running;
+    int runningQueue;
+    int quantumUsed;
+    int count;             // Procesos asignados (en cola o en ejecucion)
+    long long work;        // Tiempo restante sumado de esos procesos
+    long long busyTime;    // Unidades ejecutadas
+    int stolenIn;          // Procesos que robo a otras CPUs
+    int stolenOut;         // Procesos que otras CPUs le robaron
+    MetricsAccumulator metrics;
+    vector<int> finished;  // Handles en orden de finalizacion
+};
+
+// Scheduler MLFQ con N CPUs. Cada proceso se asigna a una CPU al llegar y
+// se planifica en las colas de esa CPU; una CPU sin procesos roba uno del
+// nivel mas alto no vacio de otra. Entre eventos globales (llegadas, una CPU
+// que se queda sin trabajo, boosts) las CPUs no interactuan y se simulan en
+// paralelo.
+class MultiCoreScheduler {
+private:
+    vector<QueueConfig> levelConfig;
+    int scheme;
+    vector<CoreState> cores;
+    vector<Process> allProcesses;       // Almacen comun: el handle es el indice
+    vector<RunState> runStates;
+    vector<QueueLink> queueLinks;
+    vector<long long> stampOffsets;
+    vector<int> pendingArrivals;
+    int arrivalCursor;
+    PlacementPolicy placement;
+    int nextPlacement;                  // PLACE_ROUND_ROBIN: proxima CPU
+    FeedbackConfig feedback;
+    bool eventDriven;
+    int jobs;                           // Hilos para simular las CPUs (0 = todos)
+    bool retainFinished;
+    shared_ptr<TimelineSink> timeline;
+    long long migrations;
+    SimTime currentTime;
+    int ioProcesses;                    // Procesos con rafagas de E/S (no se simulan)
+    vector<Process> finishedProcesses;
+    MetricsAccumulator metrics;
+    
+    void initCores(const vector<QueueConfig>& levels, int cpus);
+    int chooseCore(int handle);
+    void assign(int core, int handle, int level);
+    void stealForIdleCores();
+    void boostAll();
+    void runCore(int core, SimTime until);
+    void collectResults();
+    
+public:
+    MultiCoreScheduler(int schemeNumber, int cpus);
+    MultiCoreScheduler(const vector<QueueConfig>& levels, int cpus);
+    MultiCoreScheduler(const MultiCoreScheduler&) = delete;
+    MultiCoreScheduler& operator=(const MultiCoreScheduler&) = delete;
+    
+    int addProcess(const Process& p);
+    bool loadProcessesFromFile(const string& filename, int loadThreads, bool echo);
+    void loadTrace(const ProcessTrace& trace);
+    bool simulate();                    // false si hay procesos con E/S
+    void saveResultsToFile(const string& filename);
+    void printResults();
+    
+    void setPlacement(PlacementPolicy policy);
+    void setFeedback(const FeedbackConfig& rules);
+    void setRandomSeed(unsigned long long seed);
+    void setEventDriven(bool enabled);
+    void setJobs(int threads);
+    void setRetainFinished(bool enabled);
+    void setTimeline(shared_ptr<TimelineSink> sink);
+    
+    SimTime getCurrentTime() const;
+    int cpuCount() const;
+    int ioProcessCount() const;
+    const CoreState& getCore(int core) const;
+    long long getMigrations() const;
+    const vector<Process>& getFinishedProcesses() const;
+    const MetricsAccumulator& getMetrics() const;
+};
+
+// ---- Barrido de parametros ----
+
+// Resultado agregado de una configuracion del barrido
+struct SweepResult {
+    vector<QueueConfig> levels;
+    MetricsSummary summary;
+    SimTime makespan;
+};
+
+bool expandGridLine(const string& line, vector<vector<QueueConfig> >& configs);
+bool loadSweepGrid(const string& filename, vector<vector<QueueConfig> >& configs);
+vector<SweepResult> runSweep(const ProcessTrace& trace, const vector<vector<QueueConfig> >& configs,
+                             const FeedbackConfig& feedback, int threads);
+bool writeSweepSummary(const string& filename, const vector<SweepResult>& results);
+
+// ---- Periodos de actividad ----
+
+// Tramo [first, last) del orden de llegada que se espera sin CPU ociosa
+struct BusyPeriod {
+    int first;
+    int last;
+    SimTime start;         // AT del primero
+    long long predictedEnd;
+};
+
+// Resultado unido de simular los periodos por separado
+struct BusyPeriodRun {
+    vector<Process> finished;      // En orden de finalizacion
+    MetricsAccumulator metrics;
+    long long busyTime;
+    SimTime makespan;
+    int periods;           // Periodos previstos por las llegadas
+    int segments;          // Tramos simulados por separado (periodos agrupados)
+    int reruns;            // Tramos unidos y vueltos a simular
+
+    BusyPeriodRun();
+};
+
+vector<BusyPeriod> findBusyPeriods(const ProcessTrace& trace);
+
+// Simula los periodos en 'threads' hilos y une los resultados; false si algun
+// nivel es LOTTERY (el sorteo sigue de un periodo al otro)
+bool runBusyPeriods(const ProcessTrace& trace, const vector<QueueConfig>& levels,
+                    const FeedbackConfig& feedback, int threads, BusyPeriodRun& result);
+
+// ---- Lotes de entradas ----
+
+// Una entrada del lote: cada una con su scheduler y su .out
+struct BatchJob {
+    string input;
+    string output;
+    int scheme;
+};
+
+struct BatchResult {
+    bool ok;
+    string message;        // Motivo si no se pudo simular
+    int loadErrors;        // Lineas de la entrada ignoradas
+    int processes;
+    MetricsSummary summary;
+    SimTime makespan;
+    double millis;         // Carga + simulacion + escritura
+
+    BatchResult();
+};
+
+// 'source' es un archivo, un patron con '*'/'?' en el nombre o "@MANIFIESTO"
+// (una entrada por linea, opcionalmente "entrada;esquema"); cada salida va a
+// outputDir (se crea si falta) con el nombre de la entrada y extension .out
+bool listBatchJobs(const string& source, int scheme, const string& outputDir, vector<BatchJob>& jobs);
+vector<BatchResult> runBatch(const vector<BatchJob>& jobs, const FeedbackConfig& feedback, int threads);
+bool writeBatchSummary(const string& filename, const vector<BatchJob>& jobs, const vector<BatchResult>& results);
+
+// ---- Ajuste de quantums ----
+
+// Objetivo a minimizar: suma ponderada de RT medio, RT p99 y TAT medio
+struct TuneObjective {
+    double meanRT;
+    double p99RT;
+    double meanTAT;
+
+    TuneObjective();       // Solo RT medio
+};
+
+// "rt", "p99", "tat" o una mezcla como "rt=1,p99=0.5,tat=0.2"
+bool parseTuneObjective(const string& text, TuneObjective& objective);
+string describeTuneObjective(const TuneObjective& objective);
+double tuneScore(const TuneObjective& objective, const MetricsSummary& summary);
+
+// Una ronda de la busqueda: candidatos vivos simulados sobre un prefijo
+struct TuneRound {
+    int candidates;
+    int prefix;            // Primeros procesos en orden de llegada
+    double bestScore;
+    double millis;
+};
+
+struct TuneResult {
+    vector<QueueConfig> best;
+    MetricsSummary summary;        // Del mejor sobre la traza completa
+    double score;
+    vector<TuneRound> rounds;
+    long long simulatedProcesses;  // Suma de los prefijos simulados (costo)
+
+    TuneResult();
+};
+
+// Grilla por defecto de --tune (misma sintaxis que --sweep)
+extern const char* const DEFAULT_TUNE_GRID;
+
+// Reduccion sucesiva a la mitad: cada ronda simula los candidatos vivos en
+// 'threads' hilos sobre un prefijo de la traza que se duplica, y descarta la
+// peor mitad; la ultima ronda usa la traza completa. false si no hay candidatos.
+bool runTuner(const ProcessTrace& trace, const vector<vector<QueueConfig> >& candidates,
+              const TuneObjective& objective, const FeedbackConfig& feedback, int threads,
+              TuneResult& result);
+
+// Archivo de niveles: comentarios '#', una linea con los niveles (la misma
+// sintaxis de --levels) y otra opcional "feedback=REGLAS" con la
+// retroalimentacion con la que se ajustaron; se carga con --levels=@ARCHIVO
+bool writeTunedLevels(const string& filename, const TuneResult& result, const TuneObjective& objective,
+                      const FeedbackConfig& feedback);
+bool loadLevelsFile(const string& filename, vector<QueueConfig>& levels, FeedbackConfig& feedback,
+                    bool& hasFeedback);
+
+// ---- Cargas sinteticas ----
+
+enum ArrivalPattern {
+    ARRIVALS_POISSON,      // Llegadas independientes con tasa 'rate'
+    ARRIVALS_BURSTY        // Rafagas de procesos que llegan en el mismo tick
+};
+
+// Parametros del generador; la misma configuracion da el mismo archivo
+struct WorkloadConfig {
+    long long count;
+    unsigned long long seed;
+    ArrivalPattern arrivals;
+    double rate;            // Llegadas por unidad de tiempo (promedio)
+    double burstGroup;      // Tamano medio de las rafagas (ARRIVALS_BURSTY)
+    int btMin;              // BT ~ Pareto(btMin, btAlpha), recortado a btMax
+    double btAlpha;
+    int btMax;
+    vector<double> levelMix; // Peso de cada cola (Q = 1..N)
+
+    WorkloadConfig();
+};
+
+bool parseArrivalPattern(const string& name, ArrivalPattern& pattern);
+bool parseLevelMix(const string& text, vector<double>& mix);
+bool generateWorkload(const string& filename, const WorkloadConfig& config);
+
+// ---- Benchmark y regresion ----
+
+// Pico de memoria residente del proceso en KB (0 si no se puede medir)
+long long peakResidentKB();
+
+// Esquemas 1-3 con ambos motores sobre la traza: decisiones/s, ticks/s
+void runSchedulerBenchmark(const ProcessTrace& trace, int repeats);
+
+// Corre cada entrada del manifiesto y compara con la salida esperada;
+// devuelve la cantidad de fallas (-1 si no se pudo leer el manifiesto)
+int runRegression(const string& manifestFile);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "mt01.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Herramienta aparte (no es parte del simulador): reemplaza el operator new
+// global de todo el programa, asi que solo se enlaza en su propio ejecutable
+//
+//     mt01_alloc --in=ENTRADA [--load-threads=N]
+
+// ---- Conteo de asignaciones ----
+
+// Cuenta cada pedido de memoria al heap. El costo es un incremento atomico
+// por asignacion.
+static atomic<long long> allocationCounter(0);
+
+void* operator new(size_t size) {
+    allocationCounter.fetch_add(1, memory_order_relaxed);
+    void* p = malloc(size == 0 ? 1 : size);
+    if (p == NULL) throw bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+static long long heapAllocationCount() {
+    return allocationCounter.load(memory_order_relaxed);
+}
+
+// Simula cada esquema con ambos motores y cuenta las asignaciones hechas
+// dentro del bucle de simulate() (prepareRun() ya reservo todo antes)
+static bool runAllocationCheck(const ProcessTrace& trace) {
+    cout << "Asignaciones durante la simulacion (" << trace.size() << " procesos):" << endl;
+    bool allZero = true;
+    for (int scheme = 1; scheme <= 3; scheme++) {
+        for (int event = 0; event <= 1; event++) {
+            MLFQ_Scheduler scheduler(scheme);
+            scheduler.setEventDriven(event == 1);
+            scheduler.setTimeline(make_shared<TimelineSink>(TIMELINE_OFF));
+            scheduler.loadTrace(trace);
+            scheduler.prepareRun();
+            
+            long long before = heapAllocationCount();
+            scheduler.simulate();
+            long long allocations = heapAllocationCount() - before;
+            
+            if (allocations != 0) allZero = false;
+            printf("  esquema %d, motor %-7s tiempo final %-10lld asignaciones %lld\n", scheme,
+                   event ? "eventos" : "ticks", (long long)scheduler.getCurrentTime(), allocations);
+        }
+    }
+    cout << (allZero ? "OK: ninguna asignacion en el bucle" : "FALLA: el bucle pidio memoria") << endl;
+    return allZero;
+}
+
+// ---- MAIN ----
+
+int main(int argc, char* argv[]) {
+    string inputFile;
+    int loadThreads = 0;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg.compare(0, 5, "--in=") == 0) inputFile = arg.substr(5);
+        else if (arg.compare(0, 15, "--load-threads=") == 0) loadThreads = atoi(arg.c_str() + 15);
+        else cout << "Opcion desconocida ignorada: " << arg << endl;
+    }
+    if (inputFile.empty()) {
+        cout << "Uso: mt01_alloc --in=ENTRADA [--load-threads=N]" << endl;
+        return 1;
+    }
+    ProcessTrace trace;
+    vector<LoadError> errors;
+    if (!trace.loadFromFile(inputFile, errors, loadThreads)) {
+        cout << "Error: No se pudo abrir el archivo " << inputFile << endl;
+        return 1;
+    }
+    return runAllocationCheck(trace) ? 0 : 1;
+}
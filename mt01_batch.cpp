@@ -0,0 +1,218 @@
+#include "mt01.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+// ---- Lotes de entradas ----
+
+// Comodines de shell en un nombre: '*' cualquier texto, '?' un caracter
+static bool matchWildcard(const string& pattern, const string& name) {
+    size_t p = 0, n = 0, star = string::npos, resume = 0;
+    while (n < name.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+            p++;
+            n++;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            star = p++;
+            resume = n;
+        } else if (star != string::npos) {
+            p = star + 1;
+            n = ++resume;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') p++;
+    return p == pattern.size();
+}
+
+static bool hasWildcard(const string& text) {
+    return text.find_first_of("*?") != string::npos;
+}
+
+// Archivos del directorio que coinciden con el ultimo componente del patron,
+// ordenados por nombre (los comodines solo valen en el nombre)
+static bool expandGlob(const string& pattern, vector<string>& inputs) {
+    fs::path full(pattern);
+    fs::path directory = full.has_parent_path() ? full.parent_path() : fs::path(".");
+    string namePattern = full.filename().string();
+    error_code ec;
+    fs::directory_iterator it(directory, ec);
+    if (ec) {
+        cout << "Error: No se pudo leer el directorio " << directory.string() << endl;
+        return false;
+    }
+    vector<string> found;
+    for (; it != fs::directory_iterator(); it.increment(ec)) {
+        if (ec) break;
+        if (!it->is_regular_file(ec)) continue;
+        string name = it->path().filename().string();
+        if (matchWildcard(namePattern, name))
+            found.push_back(full.has_parent_path() ? (directory / name).string() : name);
+    }
+    sort(found.begin(), found.end());
+    inputs.insert(inputs.end(), found.begin(), found.end());
+    return true;
+}
+
+// Cada linea del manifiesto es "entrada" o "entrada;esquema", con rutas
+// relativas al manifiesto; sin esquema se usa el de --scheme
+static bool readBatchManifest(const string& manifestFile, int scheme, vector<BatchJob>& jobs) {
+    ifstream in(manifestFile.c_str());
+    if (!in) {
+        cout << "Error: No se pudo abrir el archivo " << manifestFile << endl;
+        return false;
+    }
+    fs::path base = fs::path(manifestFile).parent_path();
+    string line;
+    int lineNumber = 0;
+    while (getline(in, line)) {
+        lineNumber++;
+        if (!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+        size_t first = line.find_first_not_of(" \t");
+        if (first == string::npos || line[first] == '#') continue;
+
+        stringstream ss(line.substr(first));
+        string inputName, schemeText;
+        getline(ss, inputName, ';');
+        getline(ss, schemeText, ';');
+        BatchJob job;
+        job.scheme = scheme;
+        schemeText = trimSpaces(schemeText);
+        bool schemeOk = schemeText.empty() || parseIntText(schemeText, job.scheme);
+        if (inputName.empty() || !schemeOk || job.scheme < 1 || job.scheme > 3) {
+            cout << "Error en " << manifestFile << " linea " << lineNumber
+                 << ": se esperaba entrada o entrada;esquema" << endl;
+            return false;
+        }
+        fs::path path(inputName);
+        job.input = (path.is_absolute() || base.empty()) ? inputName : (base / path).string();
+        jobs.push_back(job);
+    }
+    return true;
+}
+
+bool listBatchJobs(const string& source, int scheme, const string& outputDir, vector<BatchJob>& jobs) {
+    jobs.clear();
+    if (!source.empty() && source[0] == '@') {
+        if (!readBatchManifest(source.substr(1), scheme, jobs)) return false;
+    } else {
+        vector<string> inputs;
+        if (hasWildcard(source)) {
+            if (!expandGlob(source, inputs)) return false;
+        } else {
+            inputs.push_back(source);
+        }
+        for (size_t i = 0; i < inputs.size(); i++) {
+            BatchJob job;
+            job.input = inputs[i];
+            job.scheme = scheme;
+            jobs.push_back(job);
+        }
+    }
+
+    // Salida = directorio + nombre de la entrada con extension .out; dos
+    // entradas con el mismo nombre se pisarian
+    vector<string> names;
+    for (size_t i = 0; i < jobs.size(); i++) {
+        jobs[i].output = (fs::path(outputDir) / fs::path(jobs[i].input).stem()).string() + ".out";
+        names.push_back(jobs[i].output);
+    }
+    sort(names.begin(), names.end());
+    for (size_t i = 1; i < names.size(); i++) {
+        if (names[i] == names[i - 1]) {
+            cout << "Error: dos entradas escribirian " << names[i] << endl;
+            return false;
+        }
+    }
+    error_code ec;
+    fs::create_directories(outputDir, ec);
+    if (!fs::is_directory(outputDir, ec)) {
+        cout << "Error: No se pudo crear el directorio " << outputDir << endl;
+        return false;
+    }
+    return true;
+}
+
+// ---- Ejecucion del lote ----
+
+BatchResult::BatchResult() : ok(false), loadErrors(0), processes(0), makespan(0), millis(0) {}
+
+static void runBatchJob(const BatchJob& job, const FeedbackConfig& feedback, BatchResult& result) {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    ProcessTrace trace;
+    vector<LoadError> errors;
+    if (!trace.loadFromFile(job.input, errors, 1)) {
+        result.message = "no se pudo leer";
+        return;
+    }
+    result.loadErrors = (int)errors.size();
+
+    MLFQ_Scheduler scheduler(job.scheme);
+    scheduler.setEventDriven(true);
+    scheduler.setFeedback(feedback);
+    scheduler.setTimeline(make_shared<TimelineSink>(TIMELINE_OFF));
+    scheduler.loadTrace(trace);
+    scheduler.simulate();
+
+    FILE* file = fopen(job.output.c_str(), "w");
+    if (file == NULL) {
+        result.message = "no se pudo crear " + job.output;
+        return;
+    }
+    writeResults(file, scheduler.getFinishedProcesses(), scheduler.getMetrics(), 1);
+    result.ok = fclose(file) == 0;
+    if (!result.ok) result.message = "no se pudo escribir " + job.output;
+    result.processes = trace.size();
+    result.summary = scheduler.getMetrics().getOverall();
+    result.makespan = scheduler.getCurrentTime();
+    result.millis = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// Las entradas mas grandes se reparten primero para que una larga no quede
+// sola al final; los resultados se guardan por indice, en el orden del lote
+vector<BatchResult> runBatch(const vector<BatchJob>& jobs, const FeedbackConfig& feedback, int threads) {
+    vector<BatchResult> results(jobs.size());
+    vector<pair<uintmax_t, int> > bySize(jobs.size());
+    for (size_t i = 0; i < jobs.size(); i++) {
+        error_code ec;
+        uintmax_t size = fs::file_size(jobs[i].input, ec);
+        bySize[i] = make_pair(ec ? 0 : size, (int)i);
+    }
+    stable_sort(bySize.begin(), bySize.end(),
+                [](const pair<uintmax_t, int>& a, const pair<uintmax_t, int>& b) { return a.first > b.first; });
+    parallelFor((int)jobs.size(), threads, [&](int k) {
+        int i = bySize[k].second;
+        runBatchJob(jobs[i], feedback, results[i]);
+    });
+    return results;
+}
+
+bool writeBatchSummary(const string& filename, const vector<BatchJob>& jobs, const vector<BatchResult>& results) {
+    FILE* file = fopen(filename.c_str(), "w");
+    if (file == NULL) {
+        cout << "Error: No se pudo crear el archivo " << filename << endl;
+        return false;
+    }
+    fprintf(file, "# entrada; esquema; procesos; WT; CT; RT; TAT; RT_p99; makespan; lineas_ignoradas; ms\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        const BatchResult& r = results[i];
+        if (!r.ok) {
+            fprintf(file, "%s;%d;ERROR %s\n", jobs[i].input.c_str(), jobs[i].scheme, r.message.c_str());
+            continue;
+        }
+        const MetricsSummary& m = r.summary;
+        fprintf(file, "%s;%d;%d;%.2f;%.2f;%.2f;%.2f;%lld;%lld;%d;%.1f\n",
+                jobs[i].input.c_str(), jobs[i].scheme, r.processes,
+                m.averageWT(), m.averageCT(), m.averageRT(), m.averageTAT(),
+                m.response.percentile(0.99), (long long)r.makespan, r.loadErrors, r.millis);
+    }
+    if (fclose(file) != 0) {
+        cout << "Error: No se pudo escribir el archivo " << filename << endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,212 @@
+#include "mt01.h"
+#include <chrono>
+#include <fstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// ---- Memoria ----
+
+long long peakResidentKB() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+    return (long long)(counters.PeakWorkingSetSize / 1024);
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;   // macOS lo informa en bytes
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+// ---- Benchmark del scheduler ----
+
+// Corre los esquemas 1-3 con cada motor 'repeats' veces (sin timeline ni
+// procesos retenidos) y muestra el mejor tiempo. Decisiones = porciones de
+// CPU despachadas; ticks = unidades de tiempo simuladas (makespan).
+void runSchedulerBenchmark(const ProcessTrace& trace, int repeats) {
+    if (repeats < 1) repeats = 1;
+    cout << "Benchmark: " << trace.size() << " procesos, mejor de " << repeats << " corridas" << endl;
+    printf("%-8s %-6s %12s %14s %14s %16s %16s\n", "esquema", "motor", "ms",
+           "decisiones", "ticks", "decisiones/s", "ticks/s");
+
+    for (int scheme = 1; scheme <= 3; scheme++) {
+        for (int engine = 0; engine < 2; engine++) {
+            double best = -1;
+            long long decisions = 0, ticks = 0;
+            for (int r = 0; r < repeats; r++) {
+                MLFQ_Scheduler scheduler(scheme);
+                scheduler.setEventDriven(engine == 1);
+                scheduler.setRetainFinished(false);
+                scheduler.setTimeline(make_shared<TimelineSink>(TIMELINE_OFF));
+                chrono::steady_clock::time_point start = chrono::steady_clock::now();
+                scheduler.loadTrace(trace);
+                scheduler.simulate();
+                double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+                if (best < 0 || ms < best) best = ms;
+                decisions = scheduler.getExecutedSlices();
+                ticks = scheduler.getCurrentTime();
+            }
+            double seconds = best > 0 ? best / 1000.0 : 1e-9;
+            printf("%-8d %-6s %12.2f %14lld %14lld %16.0f %16.0f\n", scheme,
+                   engine == 1 ? "event" : "tick", best, decisions, ticks,
+                   decisions / seconds, ticks / seconds);
+        }
+    }
+    cout << "Pico de memoria residente: " << peakResidentKB() << " KB" << endl;
+}
+
+// ---- Regresion contra salidas guardadas ----
+
+// Contenido de un archivo sin '\r' (las salidas guardadas en Windows usan CRLF)
+static bool readNormalized(FILE* file, string& text) {
+    text.clear();
+    char buffer[65536];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        for (size_t i = 0; i < n; i++) {
+            if (buffer[i] != '\r') text += buffer[i];
+        }
+    }
+    return !ferror(file);
+}
+
+static bool readNormalizedFile(const string& filename, string& text) {
+    FILE* file = fopen(filename.c_str(), "rb");
+    if (file == NULL) return false;
+    bool ok = readNormalized(file, text);
+    fclose(file);
+    return ok;
+}
+
+// Numero de la primera linea distinta (1 = primera)
+static int firstDifferentLine(const string& a, const string& b) {
+    int line = 1;
+    size_t i = 0;
+    while (i < a.size() && i < b.size() && a[i] == b[i]) {
+        if (a[i] == '\n') line++;
+        i++;
+    }
+    return line;
+}
+
+// Escribe el .out de un scheduler a un archivo temporal y lo lee de vuelta
+static bool renderResults(const vector<Process>& finished, const MetricsAccumulator& metrics, string& text) {
+    FILE* file = tmpfile();
+    if (file == NULL) return false;
+    writeResults(file, finished, metrics);
+    rewind(file);
+    bool ok = readNormalized(file, text);
+    fclose(file);
+    return ok;
+}
+
+// Directorio de 'path' con la barra final ("" si no tiene)
+static string directoryOf(const string& path) {
+    size_t slash = path.find_last_of("/\\");
+    return slash == string::npos ? "" : path.substr(0, slash + 1);
+}
+
+// Cada linea del manifiesto es "entrada;esquema;esperado" con rutas relativas
+// al manifiesto. La entrada se simula con el motor por ticks, el motor por
+// eventos y el scheduler de varias CPUs con una sola CPU; los tres deben
+// escribir exactamente el .out esperado. Un cuarto campo opcional es la
+// cantidad de lineas que el cargador debe rechazar (un caso mas).
+int runRegression(const string& manifestFile) {
+    ifstream in(manifestFile.c_str());
+    if (!in) {
+        cout << "Error: No se pudo abrir el archivo " << manifestFile << endl;
+        return -1;
+    }
+    string base = directoryOf(manifestFile);
+    string line;
+    int lineNumber = 0, cases = 0, failures = 0;
+    while (getline(in, line)) {
+        lineNumber++;
+        if (!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+        size_t first = line.find_first_not_of(" \t");
+        if (first == string::npos || line[first] == '#') continue;
+
+        stringstream ss(line.substr(first));
+        string inputName, schemeText, expectedName, rejectedText;
+        getline(ss, inputName, ';');
+        getline(ss, schemeText, ';');
+        getline(ss, expectedName, ';');
+        getline(ss, rejectedText, ';');
+        int scheme = atoi(schemeText.c_str());
+        int rejected = rejectedText.empty() ? -1 : atoi(rejectedText.c_str());
+        if (inputName.empty() || expectedName.empty() || scheme < 1 || scheme > 3) {
+            cout << "Error en " << manifestFile << " linea " << lineNumber
+                 << ": se esperaba entrada;esquema;esperado" << endl;
+            cases++;
+            failures++;
+            continue;
+        }
+
+        string expected;
+        ProcessTrace trace;
+        vector<LoadError> errors;
+        if (!readNormalizedFile(base + expectedName, expected)) {
+            cout << "FALLA " << expectedName << ": no se pudo leer" << endl;
+            cases++;
+            failures++;
+            continue;
+        }
+        if (!trace.loadFromFile(base + inputName, errors, 1)) {
+            cout << "FALLA " << inputName << ": no se pudo leer" << endl;
+            cases++;
+            failures++;
+            continue;
+        }
+        if (rejected >= 0) {
+            cases++;
+            if ((int)errors.size() == rejected) {
+                cout << "OK    " << inputName << ": " << rejected << " lineas rechazadas" << endl;
+            } else {
+                failures++;
+                cout << "FALLA " << inputName << ": " << errors.size() << " lineas rechazadas, se esperaban "
+                     << rejected << endl;
+                continue;   // Una linea aceptada de mas puede no terminar de simularse
+            }
+        }
+
+        const char* engines[] = { "tick", "event", "cpus=1" };
+        for (int engine = 0; engine < 3; engine++) {
+            string actual;
+            bool rendered;
+            if (engine < 2) {
+                MLFQ_Scheduler scheduler(scheme);
+                scheduler.setEventDriven(engine == 1);
+                scheduler.setTimeline(make_shared<TimelineSink>(TIMELINE_OFF));
+                scheduler.loadTrace(trace);
+                scheduler.simulate();
+                rendered = renderResults(scheduler.getFinishedProcesses(), scheduler.getMetrics(), actual);
+            } else {
+                MultiCoreScheduler multi(scheme, 1);
+                multi.setTimeline(make_shared<TimelineSink>(TIMELINE_OFF));
+                multi.loadTrace(trace);
+                rendered = multi.simulate() &&
+                           renderResults(multi.getFinishedProcesses(), multi.getMetrics(), actual);
+            }
+            cases++;
+            if (rendered && actual == expected) {
+                cout << "OK    " << inputName << " esquema " << scheme << " (" << engines[engine] << ")" << endl;
+            } else {
+                failures++;
+                cout << "FALLA " << inputName << " esquema " << scheme << " (" << engines[engine]
+                     << "): difiere de " << expectedName << " en la linea "
+                     << firstDifferentLine(actual, expected) << endl;
+            }
+        }
+    }
+    cout << "Regresion: " << (cases - failures) << "/" << cases << " casos correctos" << endl;
+    return failures;
+}
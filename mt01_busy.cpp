@@ -0,0 +1,152 @@
+#include "mt01.h"
+#include <algorithm>
+
+// ---- Periodos de actividad ----
+
+// Con la CPU libre y nadie listo ni bloqueado el scheduler solo avanza el
+// reloj: lo que llega despues empieza desde colas vacias. Entre periodos no
+// pasa nada que cambie las decisiones (el pass base de STRIDE solo corre
+// todos los pass por igual y los boosts caen en multiplos fijos del reloj);
+// si lo haria el estado del sorteo de LOTTERY, por eso no se usa con ese nivel.
+
+// Un proceso nuevo abre otro periodo si llega despues del fin previsto. El fin
+// se estima con la CPU de los que ya llegaron; con E/S la CPU puede quedar
+// ociosa dentro del periodo, asi que es solo un piso y se verifica al simular.
+vector<BusyPeriod> findBusyPeriods(const ProcessTrace& trace) {
+    const vector<Process>& procs = trace.getProcesses();
+    const vector<int>& order = trace.getArrivalOrder();
+    vector<BusyPeriod> periods;
+    long long end = 0;
+    for (int k = 0; k < (int)order.size(); k++) {
+        const Process& p = procs[order[k]];
+        long long at = max(p.getArrivalTime(), (SimTime)0);
+        if (periods.empty() || at > end) {
+            BusyPeriod period;
+            period.first = k;
+            period.start = (SimTime)at;
+            periods.push_back(period);
+            end = at;
+        }
+        end = max(end + p.getBurstTime(), at + p.getBurstTime() + p.getIoTime());
+        periods.back().last = k + 1;
+        periods.back().predictedEnd = end;
+    }
+    return periods;
+}
+
+BusyPeriodRun::BusyPeriodRun() : busyTime(0), makespan(0), periods(0), segments(0), reruns(0) {}
+
+// Varios periodos seguidos tambien se pueden simular juntos (el scheduler
+// salta los huecos). Se agrupan en unos pocos tramos por hilo: cada tramo
+// crea un scheduler y guarda sus metricas, y eso no vale la pena por un
+// periodo de pocos procesos.
+static const int SEGMENTS_PER_THREAD = 4;
+static const int MIN_SEGMENT_PROCESSES = 4096;
+
+static vector<BusyPeriod> groupBusyPeriods(const vector<BusyPeriod>& periods, int processes, int threads) {
+    int target = max(MIN_SEGMENT_PROCESSES, processes / (resolveThreadCount(threads) * SEGMENTS_PER_THREAD));
+    vector<BusyPeriod> segments;
+    for (size_t i = 0; i < periods.size(); i++) {
+        if (!segments.empty() && segments.back().last - segments.back().first < target) {
+            segments.back().last = periods[i].last;
+            segments.back().predictedEnd = periods[i].predictedEnd;
+        } else {
+            segments.push_back(periods[i]);
+        }
+    }
+    return segments;
+}
+
+// Resultado de simular un tramo de la traza por separado
+struct SegmentRun {
+    vector<Process> finished;
+    MetricsAccumulator metrics;
+    long long busyTime;
+    SimTime end;           // Reloj al terminar el ultimo proceso
+    bool done;
+
+    SegmentRun() : busyTime(0), end(0), done(false) {}
+};
+
+static void simulateSegment(const ProcessTrace& trace, const BusyPeriod& period,
+                            const vector<QueueConfig>& levels, const FeedbackConfig& feedback,
+                            SegmentRun& run) {
+    const vector<Process>& procs = trace.getProcesses();
+    const vector<int>& order = trace.getArrivalOrder();
+    // En orden de llegada: el orden estable de la subtraza es el mismo
+    ProcessTrace segment;
+    for (int k = period.first; k < period.last; k++) segment.addProcess(procs[order[k]]);
+    segment.finalize();
+
+    MLFQ_Scheduler scheduler(levels);
+    scheduler.setEventDriven(true);
+    scheduler.setFeedback(feedback);
+    scheduler.setTimeline(make_shared<TimelineSink>(TIMELINE_OFF));
+    scheduler.loadTrace(segment);
+    scheduler.simulate();
+
+    run.finished = scheduler.getFinishedProcesses();
+    run.metrics = scheduler.getMetrics();
+    run.busyTime = scheduler.getBusyTime();
+    run.end = scheduler.getCurrentTime();
+    run.done = true;
+}
+
+// Se simulan los tramos en paralelo. Si uno termina cuando el siguiente ya
+// llego (la prediccion fallo por la E/S), se unen y el tramo unido se vuelve
+// a simular; se repite hasta que todos los cortes son reales.
+// El resultado es el de la corrida secuencial: los terminados en orden y las
+// metricas sumadas (los histogramas se combinan sin perder nada).
+bool runBusyPeriods(const ProcessTrace& trace, const vector<QueueConfig>& levels,
+                    const FeedbackConfig& feedback, int threads, BusyPeriodRun& result) {
+    for (size_t i = 0; i < levels.size(); i++) {
+        if (levels[i].algorithm == LOTTERY) return false;
+    }
+    vector<BusyPeriod> found = findBusyPeriods(trace);
+    vector<BusyPeriod> periods = groupBusyPeriods(found, trace.size(), threads);
+    vector<SegmentRun> runs(periods.size());
+    result = BusyPeriodRun();
+    result.periods = (int)found.size();
+
+    while (true) {
+        vector<int> pending;
+        for (int i = 0; i < (int)runs.size(); i++) {
+            if (!runs[i].done) pending.push_back(i);
+        }
+        parallelFor((int)pending.size(), threads, [&](int k) {
+            simulateSegment(trace, periods[pending[k]], levels, feedback, runs[pending[k]]);
+        });
+
+        vector<BusyPeriod> merged;
+        vector<SegmentRun> mergedRuns;
+        long long reach = -1;   // Piso del fin del ultimo tramo unido
+        bool changed = false;
+        for (int i = 0; i < (int)periods.size(); i++) {
+            if (!merged.empty() && periods[i].start <= reach) {
+                merged.back().last = periods[i].last;
+                merged.back().predictedEnd = max(merged.back().predictedEnd, periods[i].predictedEnd);
+                if (mergedRuns.back().done) result.reruns++;
+                mergedRuns.back() = SegmentRun();
+                reach = max(reach, (long long)runs[i].end);
+                changed = true;
+                continue;
+            }
+            merged.push_back(periods[i]);
+            reach = runs[i].end;
+            mergedRuns.push_back(move(runs[i]));
+        }
+        periods.swap(merged);
+        runs.swap(mergedRuns);
+        if (!changed) break;
+    }
+
+    result.metrics = MetricsAccumulator((int)levels.size());
+    for (size_t i = 0; i < runs.size(); i++) {
+        result.finished.insert(result.finished.end(), runs[i].finished.begin(), runs[i].finished.end());
+        result.metrics.merge(runs[i].metrics);
+        result.busyTime += runs[i].busyTime;
+        result.makespan = runs[i].end;
+    }
+    result.segments = (int)runs.size();
+    return true;
+}
@@ -0,0 +1,542 @@
+#include "mt01.h"
+#include <cstring>
+#include <unordered_map>
+
+// ---- Formato binario ----
+
+// Cabecera: firma, version y un entero conocido para detectar un archivo de
+// otra arquitectura (los valores se guardan en el orden de bytes nativo).
+// Los tiempos van siempre en 64 bits, compilando con o sin MLFQ_TIME64.
+static const char SNAPSHOT_MAGIC[8] = { 'M', 'L', 'F', 'Q', 'S', 'N', 'A', 'P' };
+static const int SNAPSHOT_VERSION = 5;
+static const int SNAPSHOT_BYTE_ORDER = 0x01020304;
+
+// Vectores mas largos que esto indican un archivo corrupto
+static const long long SNAPSHOT_MAX_ELEMENTS = 1LL << 31;
+
+class SnapshotWriter {
+private:
+    FILE* file;
+    bool failed;
+
+public:
+    explicit SnapshotWriter(FILE* f) : file(f), failed(false) {}
+
+    void raw(const void* data, size_t size) {
+        if (!failed && size > 0 && fwrite(data, 1, size, file) != size) failed = true;
+    }
+    void i32(int value) { raw(&value, sizeof(value)); }
+    void i64(long long value) { raw(&value, sizeof(value)); }
+    void time(SimTime value) { i64(value); }
+    void flag(bool value) { char c = value ? 1 : 0; raw(&c, 1); }
+    void ints(const vector<int>& values) {
+        i64((long long)values.size());
+        if (!values.empty()) raw(&values[0], values.size() * sizeof(int));
+    }
+    void longs(const vector<long long>& values) {
+        i64((long long)values.size());
+        if (!values.empty()) raw(&values[0], values.size() * sizeof(long long));
+    }
+    void text(const string& value) {
+        i64((long long)value.size());
+        raw(value.data(), value.size());
+    }
+    bool ok() const { return !failed; }
+};
+
+class SnapshotReader {
+private:
+    FILE* file;
+    bool failed;
+
+    long long length() {
+        long long n = i64();
+        if (n < 0 || n > SNAPSHOT_MAX_ELEMENTS) failed = true;
+        return failed ? 0 : n;
+    }
+
+public:
+    explicit SnapshotReader(FILE* f) : file(f), failed(false) {}
+
+    void raw(void* data, size_t size) {
+        if (failed) {
+            memset(data, 0, size);
+            return;
+        }
+        if (size > 0 && fread(data, 1, size, file) != size) {
+            failed = true;
+            memset(data, 0, size);
+        }
+    }
+    int i32() { int value; raw(&value, sizeof(value)); return value; }
+    long long i64() { long long value; raw(&value, sizeof(value)); return value; }
+    // Un tiempo que no entra en SimTime (checkpoint de una corrida con
+    // MLFQ_TIME64 leido sin esa opcion) invalida el archivo
+    SimTime time() {
+        long long value = i64();
+        if ((SimTime)value != value) failed = true;
+        return failed ? 0 : (SimTime)value;
+    }
+    bool flag() { char c; raw(&c, 1); return c != 0; }
+    void ints(vector<int>& values) {
+        values.resize((size_t)length());
+        if (!values.empty()) raw(&values[0], values.size() * sizeof(int));
+    }
+    void longs(vector<long long>& values) {
+        values.resize((size_t)length());
+        if (!values.empty()) raw(&values[0], values.size() * sizeof(long long));
+    }
+    void text(string& value) {
+        value.resize((size_t)length());
+        if (!value.empty()) raw(&value[0], value.size());
+    }
+    void fail() { failed = true; }
+    bool ok() const { return !failed; }
+};
+
+// ---- Metricas ----
+
+void LatencyHistogram::save(SnapshotWriter& out) const {
+    out.longs(buckets);
+    out.i64(total);
+    out.i64(minValue);
+    out.i64(maxValue);
+}
+
+bool LatencyHistogram::load(SnapshotReader& in) {
+    size_t expected = buckets.size();
+    in.longs(buckets);
+    total = in.i64();
+    minValue = in.i64();
+    maxValue = in.i64();
+    if (buckets.size() != expected) in.fail();
+    return in.ok();
+}
+
+void MetricsSummary::save(SnapshotWriter& out) const {
+    out.i64(count);
+    out.i64(totalWT);
+    out.i64(totalCT);
+    out.i64(totalRT);
+    out.i64(totalTAT);
+    out.i64(totalIO);
+    waiting.save(out);
+    response.save(out);
+    turnaround.save(out);
+}
+
+bool MetricsSummary::load(SnapshotReader& in) {
+    count = in.i64();
+    totalWT = in.i64();
+    totalCT = in.i64();
+    totalRT = in.i64();
+    totalTAT = in.i64();
+    totalIO = in.i64();
+    return waiting.load(in) && response.load(in) && turnaround.load(in);
+}
+
+void MetricsAccumulator::save(SnapshotWriter& out) const {
+    overall.save(out);
+    out.i32((int)perLevel.size());
+    for (size_t i = 0; i < perLevel.size(); i++) perLevel[i].save(out);
+}
+
+bool MetricsAccumulator::load(SnapshotReader& in) {
+    if (!overall.load(in)) return false;
+    int levels = in.i32();
+    if (levels < 0 || levels > 1024) in.fail();
+    if (!in.ok()) return false;
+    perLevel.assign(levels, MetricsSummary());
+    for (int i = 0; i < levels; i++) {
+        if (!perLevel[i].load(in)) return false;
+    }
+    return true;
+}
+
+// ---- Colas ----
+
+// Los punteros a enlaces y tramos no se guardan: los vuelve a atar el scheduler
+void ProcessQueue::save(SnapshotWriter& out) const {
+    out.i32((int)algorithm);
+    out.i32(quantum);
+    out.i32(cursor);
+    out.i64(nextStamp);
+    out.i32(count);
+    out.i32(head);
+    out.i32(tail);
+    out.i32(segment);
+    out.ints(ownedSegments);
+    out.ints(heap);
+    out.ints(dirty);
+    out.i64(basePass);
+    out.ints(bucketHead);
+    out.ints(bucketTail);
+    out.ints(slots);
+    out.longs(tickets);
+    out.i64(totalTickets);
+    out.i64((long long)randomState);
+}
+
+// 'handles' = procesos del almacen: los del monticulo y el sorteo se leen
+// al atar la cola a los enlaces, asi que deben estar en rango
+bool ProcessQueue::load(SnapshotReader& in, int handles) {
+    algorithm = (SchedulingAlgorithm)in.i32();
+    quantum = in.i32();
+    cursor = in.i32();
+    nextStamp = in.i64();
+    count = in.i32();
+    head = in.i32();
+    tail = in.i32();
+    segment = in.i32();
+    in.ints(ownedSegments);
+    in.ints(heap);
+    in.ints(dirty);
+    basePass = in.i64();
+    in.ints(bucketHead);
+    in.ints(bucketTail);
+    in.ints(slots);
+    in.longs(tickets);
+    totalTickets = in.i64();
+    randomState = (unsigned long long)in.i64();
+    if (tickets.size() != slots.size() + 1) in.fail();
+    for (size_t i = 0; i < heap.size(); i++) if (heap[i] < 0 || heap[i] >= handles) in.fail();
+    for (size_t i = 0; i < slots.size(); i++) if (slots[i] < 0 || slots[i] >= handles) in.fail();
+    if (!in.ok()) heap.clear();
+    if (algorithm == PRIORITY && (bucketHead.size() != PRIORITY_LEVELS || bucketTail.size() != PRIORITY_LEVELS))
+        in.fail();
+    return in.ok();
+}
+
+// Solo los bloqueados con su despertar y su orden: al cargar se vuelven a
+// ubicar en la rueda segun el reloj guardado
+void TimerWheel::save(SnapshotWriter& out) const {
+    out.time(now);
+    out.i64(nextOrder);
+    out.i32(count);
+    for (int index = 0; index < WHEEL_LEVELS * SLOTS; index++) {
+        for (int h = slotHead[index]; h >= 0; h = next[h]) {
+            out.i32(h);
+            out.time(when[h]);
+            out.i64(order[h]);
+        }
+    }
+}
+
+bool TimerWheel::load(SnapshotReader& in, int handles) {
+    *this = TimerWheel();
+    resize(handles);
+    now = in.time();
+    nextOrder = in.i64();
+    int pending = in.i32();
+    if (pending < 0 || pending > handles) in.fail();
+    for (int i = 0; i < pending && in.ok(); i++) {
+        int handle = in.i32();
+        SimTime time = in.time();
+        long long sequence = in.i64();
+        if (handle < 0 || handle >= handles || time <= now) {
+            in.fail();
+            break;
+        }
+        when[handle] = time;
+        order[handle] = sequence;
+        count++;
+        place(handle);
+    }
+    return in.ok();
+}
+
+// ---- Procesos ----
+
+// Las etiquetas se guardan una vez en un diccionario al principio; cada
+// proceso lleva su indice en el diccionario y no el id de LabelTable, que no
+// es estable entre ejecuciones
+static void collectLabels(const vector<Process>& processes, unordered_map<int, int>& dictionary,
+                          vector<int>& labelOrder) {
+    for (size_t i = 0; i < processes.size(); i++) {
+        int id = processes[i].getLabelId();
+        if (dictionary.find(id) != dictionary.end()) continue;
+        dictionary[id] = (int)labelOrder.size();
+        labelOrder.push_back(id);
+    }
+}
+
+static void saveProcesses(SnapshotWriter& out, const vector<Process>& processes,
+                          const unordered_map<int, int>& dictionary) {
+    out.i64((long long)processes.size());
+    for (size_t i = 0; i < processes.size(); i++) {
+        const Process& p = processes[i];
+        int fields[3] = { dictionary.find(p.getLabelId())->second, p.getQueueLevel(), p.getPriority() };
+        out.raw(fields, sizeof(fields));
+        out.time(p.getBurstTime());
+        out.time(p.getArrivalTime());
+        out.time(p.getWaitingTime());
+        out.time(p.getCompletionTime());
+        out.time(p.getResponseTime());
+        out.time(p.getTurnaroundTime());
+        out.ints(p.hasIo() ? BurstTable::bursts(p.getBurstsId()) : vector<int>());
+    }
+}
+
+static bool loadProcesses(SnapshotReader& in, const vector<int>& labelIds, vector<Process>& processes) {
+    long long n = in.i64();
+    if (n < 0 || n > SNAPSHOT_MAX_ELEMENTS) in.fail();
+    processes.clear();
+    vector<int> bursts;
+    for (long long i = 0; i < n && in.ok(); i++) {
+        int fields[3];
+        in.raw(fields, sizeof(fields));
+        SimTime times[6];
+        for (int t = 0; t < 6; t++) times[t] = in.time();
+        in.ints(bursts);
+        bool validBursts = bursts.empty() || bursts.size() % 2 == 1;
+        for (size_t b = 0; b < bursts.size(); b++) if (bursts[b] < 1) validBursts = false;
+        if (fields[0] < 0 || fields[0] >= (int)labelIds.size() || !validBursts) {
+            in.fail();
+            break;
+        }
+        Process p(labelIds[fields[0]], times[0], times[1], fields[1], fields[2]);
+        if (!bursts.empty()) p.setBursts(BurstTable::add(bursts));
+        p.setWaitingTime(times[2]);
+        p.setCompletionTime(times[3]);
+        p.setResponseTime(times[4]);
+        p.setTurnaroundTime(times[5]);
+        processes.push_back(p);
+    }
+    return in.ok();
+}
+
+// ---- Scheduler ----
+
+// Orden del archivo: cabecera, configuracion, reloj y estado del bucle,
+// etiquetas, almacen (procesos, estado caliente, enlaces, tramos), llegadas
+// pendientes, colas, terminados y metricas.
+bool MLFQ_Scheduler::saveCheckpoint(const string& filename) const {
+    // Se escribe a un temporal y se renombra: un corte a mitad de escritura
+    // no pisa el checkpoint anterior
+    string temporary = filename + ".tmp";
+    FILE* file = fopen(temporary.c_str(), "wb");
+    if (file == NULL) {
+        cout << "Error: No se pudo crear el archivo " << temporary << endl;
+        return false;
+    }
+    SnapshotWriter out(file);
+    out.raw(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    out.i32(SNAPSHOT_VERSION);
+    out.i32(SNAPSHOT_BYTE_ORDER);
+
+    out.i32((int)levelConfig.size());
+    for (size_t i = 0; i < levelConfig.size(); i++) {
+        out.i32((int)levelConfig[i].algorithm);
+        out.i32(levelConfig[i].quantum);
+    }
+    out.i32(scheme);
+    out.flag(feedback.demoteOnExpiry);
+    out.time(feedback.boostPeriod);
+    out.flag(eventDriven);
+    out.flag(retainFinished);
+    out.i64((long long)randomSeed);
+
+    out.time(currentTime);
+    out.i64(executedSlices);
+    out.flag(hasRunning);
+    out.i32(running);
+    out.i32(runningQueue);
+    out.i32(rrQuantumUsed);
+    out.time(nextBoost);
+
+    unordered_map<int, int> dictionary;
+    vector<int> labelOrder;
+    collectLabels(allProcesses, dictionary, labelOrder);
+    collectLabels(finishedProcesses, dictionary, labelOrder);
+    out.i64((long long)labelOrder.size());
+    for (size_t i = 0; i < labelOrder.size(); i++) out.text(LabelTable::name(labelOrder[i]));
+
+    saveProcesses(out, allProcesses, dictionary);
+    for (size_t i = 0; i < runStates.size(); i++) {
+        const RunState& s = runStates[i];
+        int fields[2] = { s.level, s.started };
+        out.raw(fields, sizeof(fields));
+        out.time(s.remaining);
+        out.time(s.arrival);
+    }
+    for (size_t i = 0; i < queueLinks.size(); i++) {
+        const QueueLink& l = queueLinks[i];
+        int fields[5] = { l.prev, l.next, l.heapPos, l.weight, l.segment };
+        out.raw(fields, sizeof(fields));
+        out.time(l.key);
+        out.i64(l.sortKey);
+        out.i64(l.stamp);
+        out.i64(l.pass);
+        out.flag(l.dirty);
+    }
+    out.longs(stampOffsets);
+    out.ints(freeHandles);
+    out.ints(burstIndex);
+    blocked.save(out);
+    out.i64(busyTime);
+    out.time(lastBoost);
+
+    // Solo las llegadas que faltan (el prefijo ya procesado no se usa mas)
+    vector<int> pending(pendingArrivals.begin() + arrivalCursor, pendingArrivals.end());
+    out.ints(pending);
+    out.flag(arrivalsSorted);
+
+    for (size_t i = 0; i < queues.size(); i++) queues[i].save(out);
+
+    saveProcesses(out, finishedProcesses, dictionary);
+    metrics.save(out);
+
+    bool ok = out.ok();
+    if (fclose(file) != 0) ok = false;
+    if (!ok) {
+        remove(temporary.c_str());
+        cout << "Error: No se pudo escribir el archivo " << temporary << endl;
+        return false;
+    }
+#ifdef _WIN32
+    remove(filename.c_str());   // rename no reemplaza un archivo existente
+#endif
+    if (rename(temporary.c_str(), filename.c_str()) != 0) {
+        cout << "Error: No se pudo renombrar " << temporary << " a " << filename << endl;
+        return false;
+    }
+    return true;
+}
+
+// Handle valido del almacen (o -1 donde se admite "ninguno")
+static bool validHandle(int handle, int count, bool allowNone) {
+    return (allowNone && handle == -1) || (handle >= 0 && handle < count);
+}
+
+// Reemplaza todo el estado por el del checkpoint. La configuracion que no
+// forma parte de la simulacion (timeline, callback, eco, hilos) se conserva.
+bool MLFQ_Scheduler::loadCheckpoint(const string& filename) {
+    FILE* file = fopen(filename.c_str(), "rb");
+    if (file == NULL) {
+        cout << "Error: No se pudo abrir el archivo " << filename << endl;
+        return false;
+    }
+    SnapshotReader in(file);
+    char magic[sizeof(SNAPSHOT_MAGIC)];
+    in.raw(magic, sizeof(magic));
+    int version = in.i32();
+    int byteOrder = in.i32();
+    if (!in.ok() || memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) != 0 ||
+        version != SNAPSHOT_VERSION || byteOrder != SNAPSHOT_BYTE_ORDER) {
+        fclose(file);
+        cout << "Error: " << filename << " no es un checkpoint compatible" << endl;
+        return false;
+    }
+
+    int levels = in.i32();
+    if (levels <= 0 || levels > 1024) in.fail();
+    vector<QueueConfig> config;
+    for (int i = 0; i < levels && in.ok(); i++) {
+        SchedulingAlgorithm algorithm = (SchedulingAlgorithm)in.i32();
+        if (algorithm < ROUND_ROBIN || algorithm > LOTTERY) in.fail();
+        int quantum = in.i32();
+        config.push_back(QueueConfig(algorithm, quantum));
+    }
+    if (!in.ok()) config.assign(1, QueueConfig(ROUND_ROBIN, 1));
+
+    MLFQ_Scheduler restored(config);
+    restored.echoOnLoad = echoOnLoad;
+    restored.loadThreads = loadThreads;
+    restored.timeline = timeline;
+    restored.onComplete = onComplete;
+    restored.setInstrumentation(instrumented);  // Los contadores siguen desde cero
+    restored.scheme = in.i32();
+    restored.feedback.demoteOnExpiry = in.flag();
+    restored.feedback.boostPeriod = in.time();
+    restored.eventDriven = in.flag();
+    restored.retainFinished = in.flag();
+    restored.randomSeed = (unsigned long long)in.i64();
+
+    restored.currentTime = in.time();
+    restored.executedSlices = in.i64();
+    restored.hasRunning = in.flag();
+    restored.running = in.i32();
+    restored.runningQueue = in.i32();
+    restored.rrQuantumUsed = in.i32();
+    restored.nextBoost = in.time();
+
+    // Etiquetas: se vuelven a registrar en LabelTable
+    long long labels = in.i64();
+    if (labels < 0 || labels > SNAPSHOT_MAX_ELEMENTS) in.fail();
+    vector<int> labelIds;
+    string label;
+    for (long long i = 0; i < labels && in.ok(); i++) {
+        in.text(label);
+        labelIds.push_back(LabelTable::intern(label));
+    }
+
+    loadProcesses(in, labelIds, restored.allProcesses);
+    int count = (int)restored.allProcesses.size();
+    restored.runStates.resize(count);
+    for (int i = 0; i < count && in.ok(); i++) {
+        int fields[2];
+        in.raw(fields, sizeof(fields));
+        SimTime remaining = in.time();
+        SimTime arrival = in.time();
+        RunState s = { remaining, arrival, fields[0], fields[1] };
+        if (s.level < 0 || s.level >= levels) in.fail();
+        restored.runStates[i] = s;
+    }
+    restored.queueLinks.resize(count);
+    for (int i = 0; i < count && in.ok(); i++) {
+        int fields[5];
+        in.raw(fields, sizeof(fields));
+        QueueLink l = { fields[0], fields[1], fields[2], 0, 0, 0, 0, fields[4], (unsigned char)fields[3], false };
+        l.key = in.time();
+        l.sortKey = in.i64();
+        l.stamp = in.i64();
+        l.pass = in.i64();
+        l.dirty = in.flag();
+        if (fields[3] < 1 || fields[3] > PRIORITY_LEVELS) in.fail();
+        restored.queueLinks[i] = l;
+    }
+    in.longs(restored.stampOffsets);
+    in.ints(restored.freeHandles);
+    in.ints(restored.burstIndex);
+    restored.blocked.load(in, count);
+    restored.busyTime = in.i64();
+    restored.lastBoost = in.time();
+    in.ints(restored.pendingArrivals);
+    restored.arrivalCursor = 0;
+    restored.arrivalsSorted = in.flag();
+
+    for (int i = 0; i < levels && in.ok(); i++) restored.queues[i].load(in, count);
+    restored.rebindQueues();
+
+    loadProcesses(in, labelIds, restored.finishedProcesses);
+    restored.metrics.load(in);
+    fclose(file);
+
+    // Indices fuera de rango harian que la simulacion lea fuera del almacen
+    for (size_t i = 0; i < restored.pendingArrivals.size() && in.ok(); i++)
+        if (!validHandle(restored.pendingArrivals[i], count, false)) in.fail();
+    for (size_t i = 0; i < restored.freeHandles.size() && in.ok(); i++)
+        if (!validHandle(restored.freeHandles[i], count, false)) in.fail();
+    for (int i = 0; i < count && in.ok(); i++) {
+        const QueueLink& l = restored.queueLinks[i];
+        if (!validHandle(l.prev, count, true) || !validHandle(l.next, count, true) ||
+            l.segment < 0 || l.segment > (int)restored.stampOffsets.size()) in.fail();
+    }
+    if (restored.hasRunning && (!validHandle(restored.running, count, false) ||
+                                restored.runningQueue < 0 || restored.runningQueue >= levels)) in.fail();
+    if (restored.metrics.levels() != levels) in.fail();
+    if ((int)restored.burstIndex.size() != count) in.fail();
+    for (int i = 0; i < count && in.ok(); i++) {
+        int index = restored.burstIndex[i];
+        const Process& p = restored.allProcesses[i];
+        int bursts = p.hasIo() ? (int)BurstTable::bursts(p.getBurstsId()).size() : 1;
+        if (index < 0 || index >= bursts || index % 2 != 0) in.fail();
+    }
+    if (!in.ok()) {
+        cout << "Error: el checkpoint " << filename << " esta incompleto o danado" << endl;
+        return false;
+    }
+
+    *this = restored;
+    return true;
+}
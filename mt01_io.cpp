@@ -0,0 +1,248 @@
+#include "mt01.h"
+#include <charconv>
+#include <mutex>
+#include <algorithm>
+
+// ---- BurstTable ----
+
+// Las secuencias se guardan en bloques de tamano fijo que no se mueven (como
+// las etiquetas): leer un id publicado no compite con un add() concurrente.
+// No se comparten entre procesos; release() libera el id para otra.
+static const int BURST_BLOCK_BITS = 12;
+static const int BURST_BLOCK_SIZE = 1 << BURST_BLOCK_BITS;
+static const int BURST_MAX_BLOCKS = 1 << 16;
+
+struct BurstStore {
+    mutex lock;
+    vector<vector<int>*> blocks;
+    vector<int> freeIds;
+    int count;
+
+    BurstStore() : count(0) { blocks.reserve(BURST_MAX_BLOCKS); }
+    ~BurstStore() { for (size_t i = 0; i < blocks.size(); i++) delete[] blocks[i]; }
+
+    vector<int>& entry(int id) { return blocks[id >> BURST_BLOCK_BITS][id & (BURST_BLOCK_SIZE - 1)]; }
+};
+
+static BurstStore& burstStore() {
+    static BurstStore store;
+    return store;
+}
+
+int BurstTable::add(const vector<int>& bursts) {
+    BurstStore& store = burstStore();
+    lock_guard<mutex> guard(store.lock);
+    int id;
+    if (!store.freeIds.empty()) {
+        id = store.freeIds.back();
+        store.freeIds.pop_back();
+    } else {
+        id = store.count++;
+        if ((id & (BURST_BLOCK_SIZE - 1)) == 0) store.blocks.push_back(new vector<int>[BURST_BLOCK_SIZE]);
+    }
+    store.entry(id) = bursts;
+    return id;
+}
+
+void BurstTable::release(int id) {
+    BurstStore& store = burstStore();
+    lock_guard<mutex> guard(store.lock);
+    store.entry(id).clear();
+    store.freeIds.push_back(id);
+}
+
+const vector<int>& BurstTable::bursts(int id) {
+    return burstStore().entry(id);
+}
+
+// ---- Secuencias de rafagas ----
+
+static inline bool isBurstBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+bool parseBurstList(const char* first, const char* last, vector<int>& bursts) {
+    bursts.clear();
+    long long cpu = 0;
+    const char* p = first;
+    while (true) {
+        while (p < last && isBurstBlank(*p)) p++;
+        if (p == last) return false;
+        char kind = *p++;
+        bool isCpu = (kind == 'C' || kind == 'c');
+        if (!isCpu && kind != 'I' && kind != 'i') return false;
+        if (isCpu != (bursts.size() % 2 == 0)) return false;   // Deben alternar
+        int value;
+        from_chars_result result = from_chars(p, last, value);
+        if (result.ec != errc() || value < 1) return false;
+        if (isCpu) cpu += value;
+        bursts.push_back(value);
+        p = result.ptr;
+        while (p < last && isBurstBlank(*p)) p++;
+        if (p == last) break;
+        if (*p++ != ',') return false;
+    }
+    // Termina en CPU y la CPU total entra en un int (es el BT)
+    return bursts.size() % 2 == 1 && cpu <= 2147483647LL;
+}
+
+string describeBurstList(const vector<int>& bursts) {
+    string text;
+    for (int i = 0; i < (int)bursts.size(); i++) {
+        if (i > 0) text += ",";
+        text += (i % 2 == 0 ? "C" : "I") + to_string(bursts[i]);
+    }
+    return text;
+}
+
+// ---- TimerWheel ----
+
+TimerWheel::TimerWheel()
+    : now(0), count(0), nextOrder(0), slotHead(WHEEL_LEVELS * SLOTS, -1),
+      slotTail(WHEEL_LEVELS * SLOTS, -1), cachedWake(-2) {
+    for (int k = 0; k < WHEEL_LEVELS; k++) occupied[k] = 0;
+}
+
+void TimerWheel::resize(int handles) {
+    next.resize(handles, -1);
+    when.resize(handles, 0);
+    order.resize(handles, 0);
+}
+
+static inline int lowestBit(unsigned long long v) {
+    int bit = 0;
+    while ((v & 1) == 0) {
+        v >>= 1;
+        bit++;
+    }
+    return bit;
+}
+
+// Nivel del bit mas alto en que difieren el despertar y el reloj; casilla =
+// los bits del despertar en ese nivel. Las casillas ocupadas de un nivel
+// siempre estan despues de la del reloj.
+void TimerWheel::place(int handle) {
+    unsigned long long diff = (unsigned long long)when[handle] ^ (unsigned long long)now;
+    int high = 63;
+    while ((diff >> high) == 0) high--;
+    int level = high / LEVEL_BITS;
+    int slot = (int)(((long long)when[handle] >> (level * LEVEL_BITS)) & (SLOTS - 1));
+    int index = level * SLOTS + slot;
+    next[handle] = -1;
+    if (slotTail[index] >= 0) next[slotTail[index]] = handle;
+    else slotHead[index] = handle;
+    slotTail[index] = handle;
+    occupied[level] |= 1ULL << slot;
+}
+
+void TimerWheel::schedule(int handle, SimTime time) {
+    when[handle] = time;
+    order[handle] = nextOrder++;
+    count++;
+    place(handle);
+    if (cachedWake != -2 && (cachedWake < 0 || time < cachedWake)) cachedWake = time;
+}
+
+// Vacia una casilla: los que vencen ahora van a 'woken' y el resto baja de
+// nivel segun el reloj actual
+void TimerWheel::takeSlot(int level, int slot, vector<int>& woken) {
+    int index = level * SLOTS + slot;
+    int handle = slotHead[index];
+    slotHead[index] = slotTail[index] = -1;
+    occupied[level] &= ~(1ULL << slot);
+    while (handle >= 0) {
+        int following = next[handle];
+        if (when[handle] <= now) {
+            woken.push_back(handle);
+            count--;
+        } else {
+            place(handle);
+        }
+        handle = following;
+    }
+}
+
+void TimerWheel::advance(SimTime time, vector<int>& woken) {
+    if (time <= now) return;
+    if (count == 0) {
+        now = time;
+        return;
+    }
+    size_t first = woken.size();
+    while (true) {
+        // Nivel 0: las casillas del bloque de 64 actual hasta 'time'
+        long long base = now & ~(long long)(SLOTS - 1);
+        bool inBlock = time - base < SLOTS;
+        int from = (int)(now & (SLOTS - 1)) + 1;
+        int to = inBlock ? (int)(time - base) : SLOTS - 1;
+        if (from <= to) {
+            unsigned long long mask = (~0ULL << from) & (~0ULL >> (SLOTS - 1 - to));
+            unsigned long long due = occupied[0] & mask;
+            while (due != 0) {
+                int slot = lowestBit(due);
+                due &= due - 1;
+                SimTime saved = now;
+                now = (SimTime)(base + slot);
+                takeSlot(0, slot, woken);
+                now = saved;
+            }
+        }
+        if (inBlock) {
+            now = time;
+            break;
+        }
+
+        // Bloque terminado: saltar al inicio de la primera casilla ocupada
+        // de los niveles superiores (los inferiores estan vacios)
+        int level = 1;
+        while (level < WHEEL_LEVELS && occupied[level] == 0) level++;
+        if (level == WHEEL_LEVELS) {
+            now = time;
+            break;
+        }
+        int slot = lowestBit(occupied[level]);
+        int shift = level * LEVEL_BITS;
+        long long above = shift + LEVEL_BITS < 64
+                        ? ((long long)now >> (shift + LEVEL_BITS)) << (shift + LEVEL_BITS) : 0;
+        long long start = above | ((long long)slot << shift);
+        if (start > time) {
+            now = time;
+            break;
+        }
+        now = (SimTime)start;
+        takeSlot(level, slot, woken);
+    }
+    if (woken.size() > first) {
+        cachedWake = -2;
+        // Mismo tiempo: en el orden en que se bloquearon
+        sort(woken.begin() + first, woken.end(), [this](int a, int b) {
+            if (when[a] != when[b]) return when[a] < when[b];
+            return order[a] < order[b];
+        });
+    }
+}
+
+// Exacto en el nivel 0; en un nivel superior hay que mirar la casilla. El
+// resultado queda guardado hasta que alguien despierte.
+SimTime TimerWheel::nextWake() const {
+    if (cachedWake != -2) return cachedWake;
+    SimTime result = -1;
+    if (count > 0) {
+        unsigned long long ahead = occupied[0] & (~0ULL << (now & (SLOTS - 1)));
+        if (ahead != 0) {
+            result = (now & ~(SLOTS - 1)) + lowestBit(ahead);
+        } else {
+            int level = 1;
+            while (level < WHEEL_LEVELS && occupied[level] == 0) level++;
+            if (level < WHEEL_LEVELS) {
+                int index = level * SLOTS + lowestBit(occupied[level]);
+                for (int h = slotHead[index]; h >= 0; h = next[h]) {
+                    if (result < 0 || when[h] < result) result = when[h];
+                }
+            }
+        }
+    }
+    cachedWake = result;
+    return result;
+}
+
+SimTime TimerWheel::getNow() const { return now; }
+SimTime TimerWheel::wakeTime(int handle) const { return when[handle]; }
@@ -0,0 +1,393 @@
+#include "mt01.h"
+#include <charconv>
+#include <cstring>
+#include <thread>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <cstdio>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ---- Archivo mapeado en memoria ----
+
+// Vista de solo lectura del archivo completo. En POSIX usa mmap; en Windows
+// lee el archivo entero a un buffer.
+class MappedFile {
+private:
+    const char* data;
+    size_t length;
+#ifdef _WIN32
+    vector<char> buffer;
+#else
+    void* mapping;
+#endif
+
+public:
+    MappedFile() : data(NULL), length(0) {
+#ifndef _WIN32
+        mapping = NULL;
+#endif
+    }
+
+    ~MappedFile() {
+#ifndef _WIN32
+        if (mapping != NULL) munmap(mapping, length);
+#endif
+    }
+
+    bool open(const string& filename) {
+#ifdef _WIN32
+        FILE* file = fopen(filename.c_str(), "rb");
+        if (file == NULL) return false;
+        char chunk[1 << 16];
+        size_t n;
+        while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0) buffer.insert(buffer.end(), chunk, chunk + n);
+        fclose(file);
+        data = buffer.empty() ? NULL : &buffer[0];
+        length = buffer.size();
+        return true;
+#else
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0) { ::close(fd); return false; }
+        length = (size_t)st.st_size;
+        if (length > 0) {
+            mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) { mapping = NULL; ::close(fd); return false; }
+            madvise(mapping, length, MADV_SEQUENTIAL);
+            data = (const char*)mapping;
+        }
+        ::close(fd);
+        return true;
+#endif
+    }
+
+    const char* begin() const { return data; }
+    const char* end() const { return data + length; }
+    size_t size() const { return length; }
+};
+
+// ---- Parser de lineas ----
+
+static inline bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+// Convierte un campo entero admitiendo espacios alrededor y un '+' inicial
+template <class Integer>
+static bool parseIntField(const char* first, const char* last, Integer& value) {
+    while (first < last && isBlank(*first)) first++;
+    while (last > first && isBlank(*(last - 1))) last--;
+    if (first < last && *first == '+') first++;
+    if (first == last) return false;
+    from_chars_result result = from_chars(first, last, value);
+    return result.ec == errc() && result.ptr == last;
+}
+
+// Resultado de parsear un bloque de lineas
+struct ParsedChunk {
+    vector<Process> processes;
+    vector<LoadError> errors;   // numeros de linea relativos al bloque
+    long long lines;
+};
+
+static const char* FIELD_NAMES[] = { "BT", "AT", "Q", "Pr" };
+
+// BT con rafagas de E/S: "C5,I20,C3" en lugar de un numero. Deja la
+// secuencia en 'bursts' (vacia si el campo es un numero o una sola rafaga)
+// y la CPU total en 'bt'.
+static bool parseBurstField(const char* first, const char* last, SimTime& bt, vector<int>& bursts) {
+    bursts.clear();
+    const char* p = first;
+    while (p < last && isBlank(*p)) p++;
+    if (p == last || (*p != 'C' && *p != 'c')) return parseIntField(first, last, bt);
+    if (!parseBurstList(first, last, bursts)) return false;
+    bt = 0;
+    for (size_t i = 0; i < bursts.size(); i += 2) bt += bursts[i];
+    if (bursts.size() == 1) bursts.clear();
+    return true;
+}
+
+// Separa una linea "etiqueta;BT;AT;Q;Priority" (campos extra se ignoran).
+// BT puede ser una secuencia de rafagas (ver parseBurstField). BT y AT son
+// SimTime; Q y Pr, que se guardan como int, se leen igual y se verifican.
+// LINE_EMPTY para lineas vacias y comentarios; LINE_INVALID llena 'error'.
+static LineParse splitLine(const char* lineStart, const char* lineEnd, string_view& label,
+                           SimTime values[4], vector<int>& bursts, string& error) {
+    if (lineEnd > lineStart && *(lineEnd - 1) == '\r') lineEnd--;
+
+    // Ignorar lineas vacias y de comentario
+    const char* q = lineStart;
+    while (q < lineEnd && isBlank(*q)) q++;
+    if (q == lineEnd || *lineStart == '#') return LINE_EMPTY;
+
+    const char* fields[6];
+    int nFields = 0;
+    fields[nFields++] = lineStart;
+    for (const char* c = lineStart; c < lineEnd && nFields < 6; c++) {
+        if (*c == ';') fields[nFields++] = c + 1;
+    }
+    if (nFields < 5) {
+        error = "se esperaban 5 campos (etiqueta;BT;AT;Q;Pr)";
+        return LINE_INVALID;
+    }
+
+    for (int f = 0; f < 4; f++) {
+        const char* fieldEnd = (f + 2 < nFields) ? fields[f + 2] - 1 : lineEnd;
+        bool ok = f == 0 ? parseBurstField(fields[1], fieldEnd, values[0], bursts)
+                         : parseIntField(fields[f + 1], fieldEnd, values[f]);
+        if (!ok) {
+            error = string("valor invalido en el campo ") + FIELD_NAMES[f];
+            if (f == 0) error += " (un numero o rafagas como C5,I20,C3)";
+            return LINE_INVALID;
+        }
+    }
+    // Un proceso sin CPU nunca terminaria su rafaga (los motores no avanzan)
+    if (values[0] < 1) {
+        error = "BT debe ser al menos 1";
+        return LINE_INVALID;
+    }
+    for (int f = 2; f < 4; f++) {
+        if ((int)values[f] != values[f]) {
+            error = string("valor fuera de rango en el campo ") + FIELD_NAMES[f];
+            return LINE_INVALID;
+        }
+    }
+    label = string_view(lineStart, fields[1] - 1 - lineStart);
+    return LINE_PROCESS;
+}
+
+LineParse parseProcessLine(string_view line, vector<Process>& processes, string& error) {
+    string_view label;
+    SimTime values[4];
+    vector<int> bursts;
+    LineParse kind = splitLine(line.data(), line.data() + line.size(), label, values, bursts, error);
+    if (kind == LINE_PROCESS) {
+        processes.push_back(Process(LabelTable::intern(label), values[0], values[1], (int)values[2], (int)values[3]));
+        if (!bursts.empty()) processes.back().setBursts(BurstTable::add(bursts));
+    }
+    return kind;
+}
+
+static void parseChunk(const char* first, const char* last, ParsedChunk& out) {
+    out.lines = 0;
+    vector<string_view> labels;    // Etiqueta de cada linea valida
+    vector<SimTime> rows;          // BT, AT, Q, Pr de cada linea valida
+    vector<int> burstIds;          // Secuencia de rafagas de cada linea valida (-1 = ninguna)
+    vector<int> bursts;
+    string error;
+    const char* p = first;
+    while (p < last) {
+        const char* eol = (const char*)memchr(p, '\n', last - p);
+        if (eol == NULL) eol = last;
+        out.lines++;
+        const char* lineStart = p;
+        p = eol + 1;
+
+        string_view label;
+        SimTime values[4];
+        LineParse kind = splitLine(lineStart, eol, label, values, bursts, error);
+        if (kind == LINE_INVALID) out.errors.push_back(LoadError{ out.lines, error });
+        if (kind != LINE_PROCESS) continue;
+        labels.push_back(label);
+        rows.insert(rows.end(), values, values + 4);
+        burstIds.push_back(bursts.empty() ? -1 : BurstTable::add(bursts));
+    }
+
+    // Las etiquetas del bloque se guardan juntas en la tabla (un solo lock)
+    vector<int> ids;
+    LabelTable::internAll(labels, ids);
+    out.processes.reserve(ids.size());
+    for (size_t i = 0; i < ids.size(); i++) {
+        const SimTime* v = &rows[i * 4];
+        out.processes.push_back(Process(ids[i], v[0], v[1], (int)v[2], (int)v[3]));
+        if (burstIds[i] >= 0) out.processes.back().setBursts(burstIds[i]);
+    }
+}
+
+// ---- Lectura del archivo de procesos ----
+
+// Archivos por debajo de este tamano se parsean en un solo hilo
+static const size_t PARALLEL_MIN_BYTES = 4 << 20;
+
+bool parseProcessFile(const string& filename, vector<Process>& processes,
+                      vector<LoadError>& errors, int threads) {
+    MappedFile file;
+    if (!file.open(filename)) return false;
+    if (file.size() == 0) return true;
+
+    threads = resolveThreadCount(threads);
+    if (file.size() < PARALLEL_MIN_BYTES) threads = 1;
+
+    // Cortar en bloques que empiezan al inicio de una linea
+    vector<const char*> cuts;
+    cuts.push_back(file.begin());
+    for (int i = 1; i < threads; i++) {
+        const char* guess = file.begin() + file.size() * i / threads;
+        if (guess <= cuts.back()) continue;
+        const char* nl = (const char*)memchr(guess, '\n', file.end() - guess);
+        if (nl == NULL) break;
+        cuts.push_back(nl + 1);
+    }
+    cuts.push_back(file.end());
+
+    int nChunks = (int)cuts.size() - 1;
+    vector<ParsedChunk> chunks(nChunks);
+    if (nChunks == 1) {
+        parseChunk(cuts[0], cuts[1], chunks[0]);
+    } else {
+        vector<thread> workers;
+        for (int i = 0; i < nChunks; i++) {
+            workers.push_back(thread(parseChunk, cuts[i], cuts[i + 1], ref(chunks[i])));
+        }
+        for (int i = 0; i < nChunks; i++) workers[i].join();
+    }
+
+    // Unir en el orden del archivo y pasar los numeros de linea a absolutos
+    size_t total = processes.size();
+    for (int i = 0; i < nChunks; i++) total += chunks[i].processes.size();
+    processes.reserve(total);
+    long long lineOffset = 0;
+    for (int i = 0; i < nChunks; i++) {
+        for (size_t k = 0; k < chunks[i].processes.size(); k++) processes.push_back(move(chunks[i].processes[k]));
+        for (size_t k = 0; k < chunks[i].errors.size(); k++) {
+            LoadError e = chunks[i].errors[k];
+            e.line += lineOffset;
+            errors.push_back(e);
+        }
+        lineOffset += chunks[i].lines;
+    }
+    return true;
+}
+
+// Lee el archivo para un scheduler: informa las lineas con errores y, si
+// 'echo', lista cada proceso cargado (si no, solo el total)
+bool loadProcessList(const string& filename, int threads, bool echo, vector<Process>& loaded) {
+    vector<LoadError> errors;
+    if (!parseProcessFile(filename, loaded, errors, threads)) {
+        cout << "Error: No se pudo abrir el archivo " << filename << endl;
+        return false;
+    }
+
+    for (size_t i = 0; i < errors.size(); i++) {
+        cout << "Error en " << filename << " linea " << errors[i].line
+             << ": " << errors[i].message << " (linea ignorada)" << endl;
+    }
+
+    if (echo) {
+        for (size_t i = 0; i < loaded.size(); i++) {
+            const Process& process = loaded[i];
+            cout << "Proceso cargado: " << process.getLabel() << " BT=" << process.getBurstTime()
+                 << " AT=" << process.getArrivalTime() << " Q=" << process.getQueueLevel()
+                 << " Pr=" << process.getPriority();
+            if (process.hasIo()) cout << " rafagas=" << describeBurstList(BurstTable::bursts(process.getBurstsId()));
+            cout << "\n";
+        }
+    } else {
+        cout << "Procesos cargados: " << loaded.size() << endl;
+    }
+    return true;
+}
+
+bool MLFQ_Scheduler::loadProcessesFromFile(const string& filename) {
+    vector<Process> loaded;
+    if (!loadProcessList(filename, loadThreads, echoOnLoad, loaded)) return false;
+
+    allProcesses.reserve(allProcesses.size() + loaded.size());
+    runStates.reserve(runStates.size() + loaded.size());
+    queueLinks.reserve(queueLinks.size() + loaded.size());
+    pendingArrivals.reserve(pendingArrivals.size() + loaded.size());
+    for (size_t i = 0; i < loaded.size(); i++) addProcess(loaded[i]);
+    return true;
+}
+
+// ---- ProcessTrace ----
+
+bool ProcessTrace::loadFromFile(const string& filename, vector<LoadError>& errors, int threads) {
+    processes.clear();
+    if (!parseProcessFile(filename, processes, errors, threads)) return false;
+    finalize();
+    return true;
+}
+
+void ProcessTrace::addProcess(const Process& p) {
+    processes.push_back(p);
+}
+
+// Orden de llegada estable (a igual AT, el del archivo). Las llegadas
+// anteriores a 0 cuentan como llegadas en 0, igual que en el scheduler.
+void ProcessTrace::finalize() {
+    arrivalOrder.resize(processes.size());
+    for (int i = 0; i < (int)processes.size(); i++) arrivalOrder[i] = i;
+    const vector<Process>& procs = processes;
+    stable_sort(arrivalOrder.begin(), arrivalOrder.end(), [&procs](int a, int b) {
+        return max(procs[a].getArrivalTime(), (SimTime)0) < max(procs[b].getArrivalTime(), (SimTime)0);
+    });
+}
+
+const vector<Process>& ProcessTrace::getProcesses() const { return processes; }
+const vector<int>& ProcessTrace::getArrivalOrder() const { return arrivalOrder; }
+int ProcessTrace::size() const { return (int)processes.size(); }
+
+bool ProcessTrace::hasIo() const {
+    for (size_t i = 0; i < processes.size(); i++) if (processes[i].hasIo()) return true;
+    return false;
+}
+
+// Copia el estado inicial de la traza; si el scheduler esta vacio y en t=0
+// reutiliza el orden de llegada ya calculado
+void MLFQ_Scheduler::loadTrace(const ProcessTrace& trace) {
+    const vector<Process>& procs = trace.getProcesses();
+    const vector<int>& order = trace.getArrivalOrder();
+    bool reuseOrder = allProcesses.empty() && currentTime == 0 && order.size() == procs.size();
+
+    int base = (int)allProcesses.size();
+    allProcesses.insert(allProcesses.end(), procs.begin(), procs.end());
+    runStates.reserve(allProcesses.size());
+    queueLinks.reserve(allProcesses.size());
+    for (int i = 0; i < (int)procs.size(); i++) {
+        runStates.push_back(makeRunState(procs[i], levelOf(procs[i])));
+        queueLinks.push_back(makeQueueLink(procs[i]));
+    }
+    burstIndex.resize(allProcesses.size(), 0);
+    blocked.resize((int)allProcesses.size());
+    pendingArrivals.reserve(pendingArrivals.size() + procs.size());
+    if (reuseOrder) {
+        pendingArrivals.assign(order.begin(), order.end());
+        arrivalsSorted = true;
+    } else {
+        for (int i = 0; i < (int)procs.size(); i++) pendingArrivals.push_back(base + i);
+        arrivalsSorted = false;
+    }
+}
+
+// Solo los primeros 'count' procesos en orden de llegada, copiados en ese
+// orden (ya quedan ordenados); con la traza completa es loadTrace
+void MLFQ_Scheduler::loadTracePrefix(const ProcessTrace& trace, int count) {
+    const vector<Process>& procs = trace.getProcesses();
+    const vector<int>& order = trace.getArrivalOrder();
+    if (count >= (int)procs.size() || order.size() != procs.size()) {
+        loadTrace(trace);
+        return;
+    }
+    bool sorted = allProcesses.empty() && currentTime == 0;
+    int base = (int)allProcesses.size();
+    allProcesses.reserve(base + count);
+    runStates.reserve(base + count);
+    queueLinks.reserve(base + count);
+    pendingArrivals.reserve(pendingArrivals.size() + count);
+    for (int k = 0; k < count; k++) {
+        const Process& p = procs[order[k]];
+        allProcesses.push_back(p);
+        runStates.push_back(makeRunState(p, levelOf(p)));
+        queueLinks.push_back(makeQueueLink(p));
+        pendingArrivals.push_back(base + k);
+    }
+    burstIndex.resize(allProcesses.size(), 0);
+    blocked.resize((int)allProcesses.size());
+    arrivalsSorted = sorted;
+}
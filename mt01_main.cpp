@@ -0,0 +1,707 @@
+#include "mt01.h"
+#include "mt01_static.h"
+#include <cstdlib>
+#include <limits>
+#include <fstream>
+#include <chrono>
+
+// ---- MAIN ----
+
+// Modo barrido: carga la entrada una vez y simula cada configuracion de la
+// grilla en paralelo; escribe una fila de resumen por configuracion
+static int runSweepMode(const string& gridFile, const string& inputFile, const string& outputFile,
+                        const FeedbackConfig& feedback, int jobs, int loadThreads) {
+    if (inputFile.empty() || outputFile.empty()) {
+        cout << "Error: --sweep requiere --in=ENTRADA y --out=RESUMEN" << endl;
+        return 1;
+    }
+    vector<vector<QueueConfig> > configs;
+    if (!loadSweepGrid(gridFile, configs)) return 1;
+    
+    ProcessTrace trace;
+    vector<LoadError> errors;
+    if (!trace.loadFromFile(inputFile, errors, loadThreads)) {
+        cout << "Error: No se pudo abrir el archivo " << inputFile << endl;
+        return 1;
+    }
+    for (size_t i = 0; i < errors.size(); i++) {
+        cout << "Error en " << inputFile << " linea " << errors[i].line
+             << ": " << errors[i].message << " (linea ignorada)" << endl;
+    }
+    cout << "Barrido: " << configs.size() << " configuraciones sobre " << trace.size()
+         << " procesos con " << resolveThreadCount(jobs) << " hilos" << endl;
+    
+    vector<SweepResult> results = runSweep(trace, configs, feedback, jobs);
+    if (!writeSweepSummary(outputFile, results)) return 1;
+    cout << "Resumen guardado en: " << outputFile << endl;
+    return 0;
+}
+
+// Carga la traza de --in para los modos sin preguntas
+static bool loadInputTrace(const string& inputFile, const char* mode, int loadThreads, ProcessTrace& trace) {
+    if (inputFile.empty()) {
+        cout << "Error: " << mode << " requiere --in=ENTRADA" << endl;
+        return false;
+    }
+    vector<LoadError> errors;
+    if (!trace.loadFromFile(inputFile, errors, loadThreads)) {
+        cout << "Error: No se pudo abrir el archivo " << inputFile << endl;
+        return false;
+    }
+    return true;
+}
+
+// Niveles de --levels: el texto o "@ARCHIVO" (por ejemplo la salida de --tune).
+// Si el archivo trae la retroalimentacion del ajuste, se usa salvo que se haya
+// dado --feedback; si esa es otra, se avisa
+static bool resolveLevelsArg(const string& text, vector<QueueConfig>& levels, FeedbackConfig& feedback,
+                             bool feedbackGiven) {
+    if (!text.empty() && text[0] == '@') {
+        string filename = text.substr(1);
+        FeedbackConfig tuned;
+        bool hasFeedback = false;
+        if (!loadLevelsFile(filename, levels, tuned, hasFeedback)) return false;
+        if (!hasFeedback) return true;
+        if (!feedbackGiven) {
+            feedback = tuned;
+        } else if (describeFeedback(tuned) != describeFeedback(feedback)) {
+            cout << "Aviso: " << filename << " se ajusto con retroalimentacion " << describeFeedback(tuned)
+                 << "; se usa " << describeFeedback(feedback) << endl;
+        }
+        return true;
+    }
+    if (parseLevels(text, levels)) return true;
+    cout << "Error: niveles invalidos: " << text << endl;
+    return false;
+}
+
+// Modo ajuste: busca en la grilla (o en la de por defecto) los niveles que
+// minimizan el objetivo y los guarda en --out para usarlos con --levels=@
+static int runTuneMode(const string& gridFile, const string& inputFile, const string& outputFile,
+                       const TuneObjective& objective, const FeedbackConfig& feedback,
+                       int jobs, int loadThreads) {
+    if (outputFile.empty()) {
+        cout << "Error: --tune requiere --in=ENTRADA y --out=NIVELES" << endl;
+        return 1;
+    }
+    vector<vector<QueueConfig> > candidates;
+    if (gridFile.empty()) expandGridLine(DEFAULT_TUNE_GRID, candidates);
+    else if (!loadSweepGrid(gridFile, candidates)) return 1;
+    ProcessTrace trace;
+    if (!loadInputTrace(inputFile, "--tune", loadThreads, trace)) return 1;
+    cout << "Ajuste: " << candidates.size() << " candidatos sobre " << trace.size()
+         << " procesos, objetivo " << describeTuneObjective(objective) << ", con "
+         << resolveThreadCount(jobs) << " hilos" << endl;
+
+    TuneResult result;
+    if (!runTuner(trace, candidates, objective, feedback, jobs, result)) {
+        cout << "Error: no hay candidatos para ajustar" << endl;
+        return 1;
+    }
+    for (size_t r = 0; r < result.rounds.size(); r++) {
+        const TuneRound& round = result.rounds[r];
+        printf("Ronda %d: %d candidatos sobre %d procesos, mejor puntaje %.2f (%.0f ms)\n",
+               (int)r + 1, round.candidates, round.prefix, round.bestScore, round.millis);
+    }
+    printf("Simulados %lld procesos (%.1f veces la traza; el barrido completo seria %d)\n",
+           result.simulatedProcesses,
+           trace.size() > 0 ? (double)result.simulatedProcesses / trace.size() : 0.0,
+           (int)candidates.size());
+    cout << "Mejor: " << describeLevels(result.best) << endl;
+    if (!writeTunedLevels(outputFile, result, objective, feedback)) return 1;
+    cout << "Niveles guardados en: " << outputFile << " (usar con --levels=@" << outputFile << ")" << endl;
+    return 0;
+}
+
+// Modo benchmark de politicas especializadas
+static int runBenchmarkMode(const string& inputFile, int repeats, int loadThreads) {
+    ProcessTrace trace;
+    if (!loadInputTrace(inputFile, "--bench-policies", loadThreads, trace)) return 1;
+    runPolicyBenchmark(trace, repeats);
+    return 0;
+}
+
+// Modo generador de cargas sinteticas
+static int runGenerateMode(const string& outputFile, const WorkloadConfig& config) {
+    return generateWorkload(outputFile, config) ? 0 : 1;
+}
+
+// Modo benchmark del scheduler (decisiones/s, ticks/s, memoria)
+static int runSchedulerBenchMode(const string& inputFile, int repeats, int loadThreads) {
+    ProcessTrace trace;
+    if (!loadInputTrace(inputFile, "--bench", loadThreads, trace)) return 1;
+    runSchedulerBenchmark(trace, repeats);
+    return 0;
+}
+
+// Modo regresion: codigo de salida distinto de 0 si algun caso falla
+static int runRegressionMode(const string& manifestFile) {
+    return runRegression(manifestFile) == 0 ? 0 : 1;
+}
+
+// Modo lote: cada entrada con su scheduler en un pool de --jobs hilos, un
+// .out por entrada en el directorio de --out y un resumen comun
+static int runBatchMode(const string& source, const string& outputDir, int scheme,
+                        const FeedbackConfig& feedback, int jobs) {
+    if (source.empty() || outputDir.empty()) {
+        cout << "Error: --batch requiere --in=ENTRADAS y --out=DIRECTORIO" << endl;
+        return 1;
+    }
+    vector<BatchJob> batch;
+    if (!listBatchJobs(source, scheme, outputDir, batch)) return 1;
+    if (batch.empty()) {
+        cout << "Error: ninguna entrada coincide con " << source << endl;
+        return 1;
+    }
+    cout << "Lote: " << batch.size() << " entradas con " << resolveThreadCount(jobs) << " hilos" << endl;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    vector<BatchResult> results = runBatch(batch, feedback, jobs);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    int failures = 0;
+    long long processes = 0;
+    MetricsSummary total;
+    for (size_t i = 0; i < results.size(); i++) {
+        if (!results[i].ok) {
+            failures++;
+            cout << "FALLA " << batch[i].input << ": " << results[i].message << endl;
+            continue;
+        }
+        if (results[i].loadErrors > 0)
+            cout << "Aviso: " << batch[i].input << " tiene " << results[i].loadErrors << " lineas ignoradas" << endl;
+        processes += results[i].processes;
+        total.merge(results[i].summary);
+    }
+    string summaryFile = outputDir + "/resumen.txt";
+    if (!writeBatchSummary(summaryFile, batch, results)) return 1;
+    printf("Simuladas %d de %d entradas (%lld procesos) en %.2f s\n",
+           (int)batch.size() - failures, (int)batch.size(), processes, seconds);
+    if (total.count > 0) {
+        printf("Promedios del lote: WT=%.2f; CT=%.2f; RT=%.2f; TAT=%.2f\n",
+               total.averageWT(), total.averageCT(), total.averageRT(), total.averageTAT());
+    }
+    cout << "Resumen guardado en: " << summaryFile << endl;
+    return failures == 0 ? 0 : 1;
+}
+
+// Guarda la salida columnar de --columns (si se pidio)
+static void saveResultColumns(const vector<Process>& finished, const string& columnsFile) {
+    if (!columnsFile.empty()) writeResultColumns(columnsFile, finished);
+}
+
+// Periodos de actividad: la traza se corta donde la CPU queda ociosa y los
+// tramos se simulan en paralelo; el .out es el de la corrida secuencial
+static int runBusyPeriodMode(const vector<QueueConfig>& levels, const string& inputFile, const string& outputFile,
+                             const FeedbackConfig& feedback, int jobs, int loadThreads, bool echoOnLoad,
+                             const string& columnsFile) {
+    vector<Process> loaded;
+    if (!loadProcessList(inputFile, loadThreads, echoOnLoad, loaded)) {
+        cout << "Error cargando el archivo de entrada." << endl;
+        return 1;
+    }
+    ProcessTrace trace;
+    for (size_t i = 0; i < loaded.size(); i++) trace.addProcess(loaded[i]);
+    trace.finalize();
+
+    BusyPeriodRun run;
+    if (!runBusyPeriods(trace, levels, feedback, jobs, run)) {
+        cout << "Error: " << describeLevels(levels) << " tiene un nivel LOTTERY, que no se puede"
+             << " cortar en periodos de actividad" << endl;
+        return 1;
+    }
+    printResultsTable(run.finished, run.metrics);
+    if (run.makespan > 0) {
+        printf("Utilizacion de CPU: %.2f%% (%lld de %lld unidades)\n",
+               100.0 * run.busyTime / run.makespan, run.busyTime, (long long)run.makespan);
+    }
+    cout << "Periodos de actividad: " << run.periods << " en " << run.segments << " tramos ("
+         << run.reruns << " vueltos a simular) con " << resolveThreadCount(jobs) << " hilos" << endl;
+    writeResultsFile(outputFile, run.finished, run.metrics);
+    saveResultColumns(run.finished, columnsFile);
+    return 0;
+}
+
+// Guarda las estadisticas de --stats (si se pidieron)
+static void saveSchedulerStats(const MLFQ_Scheduler& scheduler, const string& statsFile, ostream& console) {
+    if (statsFile.empty()) return;
+    if (scheduler.saveStats(statsFile)) console << "Estadisticas guardadas en: " << statsFile << endl;
+}
+
+// Traza binaria de --trace (si se pidio) con los niveles del scheduler;
+// null si no se pidio o no se pudo crear el archivo
+static shared_ptr<IntervalTraceWriter> createIntervalTrace(const string& traceFile, const vector<QueueConfig>& levels,
+                                                          ostream& console) {
+    if (traceFile.empty()) return nullptr;
+    shared_ptr<IntervalTraceWriter> writer = make_shared<IntervalTraceWriter>();
+    if (!writer->create(traceFile, levels)) {
+        console << "Error: No se pudo crear el archivo " << traceFile << endl;
+        return nullptr;
+    }
+    return writer;
+}
+
+// Escribe el indice de la traza al terminar la simulacion
+static void finishIntervalTrace(const shared_ptr<IntervalTraceWriter>& writer, const string& traceFile,
+                                ostream& console) {
+    if (!writer) return;
+    if (writer->close()) console << "Traza guardada en: " << traceFile << " (" << writer->getIntervals() << " intervalos)" << endl;
+    else console << "Error: No se pudo escribir el archivo " << traceFile << endl;
+}
+
+// Sigue cada configuracion de la grilla desde el mismo punto del checkpoint,
+// en paralelo, y escribe una fila de resumen por configuracion
+static int runVariants(const MLFQ_Scheduler& base, const string& gridFile, const string& outputFile, int jobs) {
+    if (outputFile.empty()) {
+        cout << "Error: --variants requiere --out=RESUMEN" << endl;
+        return 1;
+    }
+    vector<vector<QueueConfig> > configs;
+    if (!loadSweepGrid(gridFile, configs)) return 1;
+    for (size_t i = 0; i < configs.size(); i++) {
+        if (configs[i].size() != base.getLevels().size()) {
+            cout << "Error: " << describeLevels(configs[i]) << " no tiene " << base.getLevels().size()
+                 << " niveles como el checkpoint" << endl;
+            return 1;
+        }
+    }
+    cout << "Variantes: " << configs.size() << " configuraciones desde t=" << base.getCurrentTime()
+         << " con " << resolveThreadCount(jobs) << " hilos" << endl;
+    
+    vector<SweepResult> results(configs.size());
+    parallelFor((int)configs.size(), jobs, [&](int i) {
+        MLFQ_Scheduler variant = base.fork();
+        variant.setLevels(configs[i]);
+        variant.drain();
+        results[i].levels = configs[i];
+        results[i].summary = variant.getMetrics().getOverall();
+        results[i].makespan = variant.getCurrentTime();
+    });
+    if (!writeSweepSummary(outputFile, results)) return 1;
+    cout << "Resumen guardado en: " << outputFile << endl;
+    return 0;
+}
+
+// Modo reanudar: carga un checkpoint y sigue la simulacion (opcionalmente
+// con otros niveles), o la divide en variantes con --variants
+static int runResumeMode(const string& checkpoint, const string& levelsText, const string& variantsGrid,
+                         const string& outputFile, int jobs, TimelineLevel timelineLevel,
+                         const string& timelineFile, const string& checkpointFile, SimTime checkpointEvery,
+                         const string& statsFile, bool reseed, unsigned long long seed,
+                         const string& traceFile, const string& columnsFile) {
+    shared_ptr<TimelineSink> timeline = make_shared<TimelineSink>(timelineLevel);
+    if (!timelineFile.empty() && !timeline->openFile(timelineFile)) {
+        cout << "Error: No se pudo crear el archivo " << timelineFile << endl;
+        return 1;
+    }
+    MLFQ_Scheduler scheduler(2);
+    scheduler.setTimeline(timeline);
+    if (!scheduler.loadCheckpoint(checkpoint)) return 1;
+    cout << "Reanudando " << checkpoint << " en t=" << scheduler.getCurrentTime() << " ("
+         << describeLevels(scheduler.getLevels()) << ")" << endl;
+    
+    if (!variantsGrid.empty()) return runVariants(scheduler, variantsGrid, outputFile, jobs);
+    
+    if (!levelsText.empty()) {
+        // La retroalimentacion sigue siendo la del checkpoint
+        vector<QueueConfig> levels;
+        FeedbackConfig feedback = scheduler.getFeedback();
+        if (!resolveLevelsArg(levelsText, levels, feedback, true)) return 1;
+        if (!scheduler.setLevels(levels)) {
+            cout << "Error: niveles invalidos para el checkpoint: " << levelsText << endl;
+            return 1;
+        }
+        cout << "Continuando con " << describeLevels(levels) << endl;
+    }
+    if (reseed) scheduler.setRandomSeed(seed);
+    if (outputFile.empty()) {
+        cout << "Error: --resume requiere --out=SALIDA" << endl;
+        return 1;
+    }
+    shared_ptr<IntervalTraceWriter> trace = createIntervalTrace(traceFile, scheduler.getLevels(), cout);
+    if (!traceFile.empty() && !trace) return 1;
+    scheduler.setIntervalTrace(trace);
+    scheduler.setCheckpointInterval(checkpointFile, checkpointEvery);
+    scheduler.setInstrumentation(!statsFile.empty());
+    scheduler.simulate();
+    scheduler.printResults();
+    scheduler.saveResultsToFile(outputFile);
+    saveResultColumns(scheduler.getFinishedProcesses(), columnsFile);
+    saveSchedulerStats(scheduler, statsFile, cout);
+    finishIntervalTrace(trace, traceFile, cout);
+    return 0;
+}
+
+// Modo en linea: procesos desde stdin ("-") o un archivo/FIFO, resultados a
+// stdout o a --out. Sin --timeline-file no hay timeline (la consola es la salida).
+static int runStreamMode(const string& source, const string& outputFile, int scheme,
+                         const vector<QueueConfig>& customLevels, bool eventDriven, const FeedbackConfig& feedback,
+                         TimelineLevel timelineLevel, const string& timelineFile, const string& statsFile,
+                         const string& traceFile) {
+    shared_ptr<TimelineSink> timeline = make_shared<TimelineSink>(timelineFile.empty() ? TIMELINE_OFF : timelineLevel);
+    if (!timelineFile.empty() && !timeline->openFile(timelineFile)) {
+        cerr << "Error: No se pudo crear el archivo " << timelineFile << endl;
+        return 1;
+    }
+    ifstream file;
+    if (source != "-") {
+        file.open(source.c_str());
+        if (!file) {
+            cerr << "Error: No se pudo abrir el archivo " << source << endl;
+            return 1;
+        }
+    }
+    FILE* out = stdout;
+    if (!outputFile.empty()) {
+        out = fopen(outputFile.c_str(), "w");
+        if (out == NULL) {
+            cerr << "Error: No se pudo crear el archivo " << outputFile << endl;
+            return 1;
+        }
+    }
+    
+    MLFQ_Scheduler scheduler = customLevels.empty() ? MLFQ_Scheduler(scheme) : MLFQ_Scheduler(customLevels);
+    scheduler.setEventDriven(eventDriven);
+    scheduler.setFeedback(feedback);
+    scheduler.setTimeline(timeline);
+    scheduler.setInstrumentation(!statsFile.empty());
+    shared_ptr<IntervalTraceWriter> trace = createIntervalTrace(traceFile, scheduler.getLevels(), cerr);
+    if (!traceFile.empty() && !trace) return 1;
+    scheduler.setIntervalTrace(trace);
+    bool ok = runProcessStream(source == "-" ? cin : file, out, scheduler);
+    timeline->flush();
+    saveSchedulerStats(scheduler, statsFile, cerr);
+    finishIntervalTrace(trace, traceFile, cerr);
+    if (out != stdout) fclose(out);
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    // Opciones de linea de comandos:
+    //   --engine=tick (por defecto) o --engine=event
+    //   --no-echo            no listar cada proceso al cargarlo
+    //   --load-threads=N     hilos para parsear la entrada (0 = todos)
+    //   --timeline=NIVEL     off, summary, decisions o ticks (por defecto)
+    //   --timeline-file=F    escribir el timeline en F en vez de la consola
+    //   --no-retain          no guardar cada proceso terminado (solo metricas)
+    //   --feedback=REGLAS    off (por defecto), demote, boost=S o demote,boost=S
+    //   --cpus=N             simular N CPUs con colas propias y robo de trabajo
+    //   --placement=P        hash, least (por defecto) o rr: CPU de cada llegada
+    //   --jobs=N             hilos para el barrido o para simular las CPUs
+    //   --sweep=GRILLA --in=ENTRADA --out=RESUMEN [--jobs=N]
+    //                        barrido de configuraciones, sin preguntas
+    //   --bench-policies --in=ENTRADA [--repeat=N]
+    //                        esquemas 1-3 especializados vs. dinamicos
+    //   --generate=SALIDA [--count=N] [--seed=S] [--arrivals=poisson|bursty]
+    //                     [--rate=L] [--burst-size=G] [--mix=40,30,20,10]
+    //                     [--bt-min=M] [--bt-alpha=A] [--bt-max=X]
+    //                        genera una carga sintetica reproducible
+    //   --bench --in=ENTRADA [--repeat=N]
+    //                        decisiones/s y ticks/s de los esquemas 1-3
+    //   --regress=MANIFIESTO compara contra las salidas guardadas
+    //   --checkpoint=F --checkpoint-every=T
+    //                        guardar el estado cada T unidades ("{t}" en F
+    //                        se reemplaza por el tiempo; si no, se pisa)
+    //   --levels=NIVELES     niveles propios (por ejemplo "RR(2),RR(6),STCF")
+    //                        en vez del esquema, sin preguntarlo; "@F" los lee
+    //                        del archivo F (la salida de --tune)
+    //   --tune[=GRILLA] --in=ENTRADA --out=NIVELES [--objective=OBJ] [--jobs=N]
+    //                        busca los quantums y politicas que minimizan OBJ
+    //                        (rt, p99, tat o "rt=1,p99=0.5,tat=0.2") por
+    //                        reduccion sucesiva a la mitad sobre prefijos
+    //   --resume=F --out=SALIDA [--levels=NIVELES] [--seed=S]
+    //                        seguir desde un checkpoint, opcionalmente con
+    //                        otros niveles (misma cantidad) y otra semilla
+    //                        para los sorteos de LOTTERY
+    //   --resume=F --variants=GRILLA --out=RESUMEN [--jobs=N]
+    //                        seguir cada configuracion desde el checkpoint
+    //   --stats=F.json       contadores del scheduler (cambios de contexto,
+    //                        preempciones, ocupacion de colas, cronometros)
+    //                        en JSON al terminar; solo con una CPU
+    //   --stream[=FIFO] [--scheme=N] [--out=SALIDA]
+    //                        simulacion en linea: lee procesos de stdin (o del
+    //                        archivo/FIFO) y escribe cada uno al terminar
+    //   --batch --in=ENTRADAS --out=DIRECTORIO [--scheme=N] [--jobs=N]
+    //                        sin preguntas: ENTRADAS es un archivo, un patron
+    //                        ("mlq*.txt") o @MANIFIESTO; un .out por entrada
+    //                        en DIRECTORIO y un resumen (resumen.txt)
+    //   --busy-periods       corta la entrada donde la CPU queda ociosa y
+    //                        simula los tramos en --jobs hilos (una CPU)
+    //   --columns=F          ademas del .out, los resultados por columnas
+    //                        (un entero por metrica y diccionario de etiquetas)
+    //   --trace=F            traza binaria de intervalos de CPU (inicio, fin,
+    //                        proceso, nivel, motivo) con indice; una CPU
+    //   --trace-query=F [--at=T] [--proc=ETIQUETA] [--window=T0,T1] [--chrome=F.json]
+    //                        que corria en T, intervalos de un proceso,
+    //                        actividad por nivel en [T0,T1) o exportar la
+    //                        ventana al formato de eventos de Chrome
+    bool eventDriven = false;
+    bool echoOnLoad = true;
+    int loadThreads = 0;
+    TimelineLevel timelineLevel = TIMELINE_TICKS;
+    string timelineFile;
+    bool retainFinished = true;
+    FeedbackConfig feedback;
+    bool feedbackGiven = false;
+    int cpus = 1;
+    PlacementPolicy placement = PLACE_LEAST_LOADED;
+    string sweepGrid, inputArg, outputArg;
+    int jobs = 0;
+    bool benchPolicies = false;
+    int repeats = 3;
+    string generateFile;
+    WorkloadConfig workload;
+    bool seedGiven = false;
+    bool bench = false;
+    string regressManifest;
+    string streamSource;
+    int schemeArg = 0;
+    string checkpointFile, resumeFile, levelsArg, variantsGrid;
+    SimTime checkpointEvery = 0;
+    string statsFile;
+    string traceFile, traceQueryFile;
+    TraceQuery traceQuery;
+    bool batch = false;
+    bool busyPeriods = false;
+    string columnsFile;
+    bool tune = false;
+    string tuneGrid;
+    TuneObjective objective;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--engine=event") eventDriven = true;
+        else if (arg == "--engine=tick") eventDriven = false;
+        else if (arg == "--no-echo") echoOnLoad = false;
+        else if (arg.compare(0, 15, "--load-threads=") == 0) loadThreads = atoi(arg.c_str() + 15);
+        else if (arg.compare(0, 11, "--timeline=") == 0) {
+            if (!parseTimelineLevel(arg.substr(11), timelineLevel))
+                cout << "Nivel de timeline desconocido: " << arg.substr(11) << endl;
+        }
+        else if (arg.compare(0, 16, "--timeline-file=") == 0) timelineFile = arg.substr(16);
+        else if (arg == "--no-retain") retainFinished = false;
+        else if (arg.compare(0, 11, "--feedback=") == 0) {
+            if (parseFeedback(arg.substr(11), feedback)) feedbackGiven = true;
+            else cout << "Reglas de retroalimentacion invalidas: " << arg.substr(11) << endl;
+        }
+        else if (arg.compare(0, 7, "--cpus=") == 0) cpus = max(1, atoi(arg.c_str() + 7));
+        else if (arg.compare(0, 12, "--placement=") == 0) {
+            if (!parsePlacement(arg.substr(12), placement))
+                cout << "Politica de ubicacion desconocida: " << arg.substr(12) << endl;
+        }
+        else if (arg.compare(0, 8, "--sweep=") == 0) sweepGrid = arg.substr(8);
+        else if (arg.compare(0, 5, "--in=") == 0) inputArg = arg.substr(5);
+        else if (arg.compare(0, 6, "--out=") == 0) outputArg = arg.substr(6);
+        else if (arg.compare(0, 7, "--jobs=") == 0) jobs = atoi(arg.c_str() + 7);
+        else if (arg == "--bench-policies") benchPolicies = true;
+        else if (arg.compare(0, 9, "--repeat=") == 0) repeats = atoi(arg.c_str() + 9);
+        else if (arg.compare(0, 11, "--generate=") == 0) generateFile = arg.substr(11);
+        else if (arg.compare(0, 8, "--count=") == 0) workload.count = atoll(arg.c_str() + 8);
+        else if (arg.compare(0, 7, "--seed=") == 0) {
+            workload.seed = strtoull(arg.c_str() + 7, NULL, 10);
+            seedGiven = true;
+        }
+        else if (arg.compare(0, 11, "--arrivals=") == 0) {
+            if (!parseArrivalPattern(arg.substr(11), workload.arrivals))
+                cout << "Patron de llegadas desconocido: " << arg.substr(11) << endl;
+        }
+        else if (arg.compare(0, 7, "--rate=") == 0) workload.rate = atof(arg.c_str() + 7);
+        else if (arg.compare(0, 13, "--burst-size=") == 0) workload.burstGroup = atof(arg.c_str() + 13);
+        else if (arg.compare(0, 6, "--mix=") == 0) {
+            if (!parseLevelMix(arg.substr(6), workload.levelMix))
+                cout << "Mezcla de colas invalida: " << arg.substr(6) << endl;
+        }
+        else if (arg.compare(0, 9, "--bt-min=") == 0) workload.btMin = atoi(arg.c_str() + 9);
+        else if (arg.compare(0, 11, "--bt-alpha=") == 0) workload.btAlpha = atof(arg.c_str() + 11);
+        else if (arg.compare(0, 9, "--bt-max=") == 0) workload.btMax = atoi(arg.c_str() + 9);
+        else if (arg == "--bench") bench = true;
+        else if (arg == "--batch") batch = true;
+        else if (arg == "--busy-periods") busyPeriods = true;
+        else if (arg.compare(0, 10, "--columns=") == 0) columnsFile = arg.substr(10);
+        else if (arg.compare(0, 10, "--regress=") == 0) regressManifest = arg.substr(10);
+        else if (arg.compare(0, 13, "--checkpoint=") == 0) checkpointFile = arg.substr(13);
+        else if (arg.compare(0, 19, "--checkpoint-every=") == 0) checkpointEvery = (SimTime)atoll(arg.c_str() + 19);
+        else if (arg.compare(0, 9, "--resume=") == 0) resumeFile = arg.substr(9);
+        else if (arg.compare(0, 9, "--levels=") == 0) levelsArg = arg.substr(9);
+        else if (arg == "--tune") tune = true;
+        else if (arg.compare(0, 7, "--tune=") == 0) {
+            tune = true;
+            tuneGrid = arg.substr(7);
+        }
+        else if (arg.compare(0, 12, "--objective=") == 0) {
+            if (!parseTuneObjective(arg.substr(12), objective))
+                cout << "Objetivo invalido: " << arg.substr(12) << " (se usa rt)" << endl;
+        }
+        else if (arg.compare(0, 11, "--variants=") == 0) variantsGrid = arg.substr(11);
+        else if (arg.compare(0, 8, "--stats=") == 0) statsFile = arg.substr(8);
+        else if (arg == "--stream") streamSource = "-";
+        else if (arg.compare(0, 9, "--stream=") == 0) streamSource = arg.substr(9);
+        else if (arg.compare(0, 9, "--scheme=") == 0) {
+            schemeArg = atoi(arg.c_str() + 9);
+            if (schemeArg < 1 || schemeArg > 3) {
+                cout << "Esquema invalido: " << arg.substr(9) << " (se usa el 2)" << endl;
+                schemeArg = 2;
+            }
+        }
+        else if (arg.compare(0, 8, "--trace=") == 0) traceFile = arg.substr(8);
+        else if (arg.compare(0, 14, "--trace-query=") == 0) traceQueryFile = arg.substr(14);
+        else if (arg.compare(0, 5, "--at=") == 0) traceQuery.at = max(0LL, atoll(arg.c_str() + 5));
+        else if (arg.compare(0, 7, "--proc=") == 0) traceQuery.label = arg.substr(7);
+        else if (arg.compare(0, 9, "--window=") == 0) {
+            if (!parseTraceWindow(arg.substr(9), traceQuery.from, traceQuery.to)) {
+                cout << "Ventana invalida (se esperaba T0,T1 con T0 < T1): " << arg.substr(9) << endl;
+                traceQuery.from = traceQuery.to = -1;
+            }
+        }
+        else if (arg.compare(0, 9, "--chrome=") == 0) traceQuery.chromeFile = arg.substr(9);
+        else cout << "Opcion desconocida ignorada: " << arg << endl;
+    }
+    
+    // Con --resume los niveles se aplican al checkpoint
+    vector<QueueConfig> customLevels;
+    if (!levelsArg.empty() && resumeFile.empty() && !resolveLevelsArg(levelsArg, customLevels, feedback, feedbackGiven)) return 1;
+
+    // En modo en linea la consola lleva los resultados
+    if (!streamSource.empty() && !columnsFile.empty()) cerr << "Aviso: --columns no se usa en modo en linea" << endl;
+    if (!streamSource.empty())
+        return runStreamMode(streamSource, outputArg, schemeArg > 0 ? schemeArg : 2, customLevels, eventDriven,
+                             feedback, timelineLevel, timelineFile, statsFile, traceFile);
+    cout << "=== SIMULADOR MLFQ (Multilevel Feedback Queue) ===" << endl;
+
+    if (batch) return runBatchMode(inputArg, outputArg, schemeArg > 0 ? schemeArg : 2, feedback, jobs);
+    if (!sweepGrid.empty()) return runSweepMode(sweepGrid, inputArg, outputArg, feedback, jobs, loadThreads);
+    if (tune) return runTuneMode(tuneGrid, inputArg, outputArg, objective, feedback, jobs, loadThreads);
+    if (benchPolicies) return runBenchmarkMode(inputArg, repeats, loadThreads);
+    if (!generateFile.empty()) return runGenerateMode(generateFile, workload);
+    if (bench) return runSchedulerBenchMode(inputArg, repeats, loadThreads);
+    if (!regressManifest.empty()) return runRegressionMode(regressManifest);
+    if (!traceQueryFile.empty()) return runTraceQuery(traceQueryFile, traceQuery) ? 0 : 1;
+    if (!resumeFile.empty())
+        return runResumeMode(resumeFile, levelsArg, variantsGrid, outputArg, jobs, timelineLevel,
+                             timelineFile, checkpointFile, checkpointEvery, statsFile,
+                             seedGiven, workload.seed, traceFile, columnsFile);
+    
+    // Permitir al usuario seleccionar el esquema de colas (salvo con --levels)
+    int scheme = 2;
+    if (!customLevels.empty()) {
+        cout << "Usando niveles: " << describeLevels(customLevels) << endl;
+    } else {
+        cout << "Seleccione el esquema (1, 2 o 3):" << endl;
+        cout << "  1) RR(1), RR(3), RR(4), SJF" << endl;
+        cout << "  2) RR(2), RR(3), RR(4), STCF" << endl;
+        cout << "  3) RR(3), RR(5), RR(6), RR(20)" << endl;
+        cout << "Ingrese opcion [1-3] (Enter para 2 por defecto): ";
+        string schemeInput;
+        getline(cin, schemeInput);
+        if (schemeInput.empty()) {
+            scheme = 2;
+        } else {
+            // Si previamente se usó >> para leer, puede quedar un salto pendiente; intentar parsear robustamente
+            stringstream ss(schemeInput);
+            int opt = 2;
+            if (ss >> opt) {
+                if (opt >= 1 && opt <= 3) scheme = opt; else scheme = 2;
+            }
+        }
+        switch (scheme) {
+            case 1:
+                cout << "Usando esquema 1: RR(1), RR(3), RR(4), SJF" << endl;
+                break;
+            case 2:
+                cout << "Usando esquema 2: RR(2), RR(3), RR(4), STCF" << endl;
+                break;
+            case 3:
+                cout << "Usando esquema 3: RR(3), RR(5), RR(6), RR(20)" << endl;
+                break;
+            default:
+                cout << "Opcion invalida, usando esquema 2 por defecto: RR(2), RR(3), RR(4), STCF" << endl;
+                scheme = 2;
+                break;
+        }
+    }
+    
+    string inputFile, outputFile;
+    cout << "Ingrese el nombre del archivo de entrada: ";
+    cin >> inputFile;
+    cout << "Ingrese el nombre del archivo de salida: ";
+    cin >> outputFile;
+    // Limpiar el buffer por si quedan saltos de linea para futuros getline
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    
+    shared_ptr<TimelineSink> timeline = make_shared<TimelineSink>(timelineLevel);
+    if (!timelineFile.empty() && !timeline->openFile(timelineFile)) {
+        cout << "Error: No se pudo crear el archivo " << timelineFile << endl;
+        return 1;
+    }
+    
+    // Varias CPUs: scheduler con colas por CPU (el timeline solo muestra el resumen)
+    if (cpus > 1) {
+        if (checkpointEvery > 0) cout << "Aviso: los checkpoints solo se guardan con una CPU" << endl;
+        if (!statsFile.empty()) cout << "Aviso: --stats solo se guarda con una CPU" << endl;
+        if (!traceFile.empty()) cout << "Aviso: --trace solo se guarda con una CPU" << endl;
+        if (busyPeriods) cout << "Aviso: --busy-periods solo con una CPU" << endl;
+        unique_ptr<MultiCoreScheduler> owned(customLevels.empty() ? new MultiCoreScheduler(scheme, cpus)
+                                                                  : new MultiCoreScheduler(customLevels, cpus));
+        MultiCoreScheduler& multi = *owned;
+        multi.setPlacement(placement);
+        multi.setFeedback(feedback);
+        multi.setEventDriven(eventDriven);
+        multi.setJobs(jobs);
+        multi.setRetainFinished(retainFinished);
+        multi.setTimeline(timeline);
+        if (!multi.loadProcessesFromFile(inputFile, loadThreads, echoOnLoad)) {
+            cout << "Error cargando el archivo de entrada." << endl;
+            return 1;
+        }
+        if (!multi.simulate()) {
+            cout << "Error: " << multi.ioProcessCount() << " procesos tienen rafagas de E/S, que no se"
+                 << " simulan con varias CPUs (usar --cpus=1)" << endl;
+            return 1;
+        }
+        multi.printResults();
+        multi.saveResultsToFile(outputFile);
+        saveResultColumns(multi.getFinishedProcesses(), columnsFile);
+        return 0;
+    }
+    
+    if (busyPeriods) {
+        if (checkpointEvery > 0) cout << "Aviso: --busy-periods no guarda checkpoints" << endl;
+        if (!statsFile.empty()) cout << "Aviso: --busy-periods no guarda --stats" << endl;
+        if (!traceFile.empty()) cout << "Aviso: --busy-periods no guarda --trace" << endl;
+        return runBusyPeriodMode(customLevels.empty() ? schemeLevels(scheme) : customLevels, inputFile, outputFile, feedback, jobs, loadThreads, echoOnLoad,
+                                 columnsFile);
+    }
+    
+    // Crear el scheduler
+    MLFQ_Scheduler scheduler = customLevels.empty() ? MLFQ_Scheduler(scheme) : MLFQ_Scheduler(customLevels);
+    scheduler.setEventDriven(eventDriven);
+    scheduler.setLoadEcho(echoOnLoad);
+    scheduler.setLoadThreads(loadThreads);
+    scheduler.setRetainFinished(retainFinished);
+    scheduler.setFeedback(feedback);
+    scheduler.setTimeline(timeline);
+    scheduler.setCheckpointInterval(checkpointFile, checkpointEvery);
+    scheduler.setInstrumentation(!statsFile.empty());
+    shared_ptr<IntervalTraceWriter> trace = createIntervalTrace(traceFile, scheduler.getLevels(), cout);
+    if (!traceFile.empty() && !trace) return 1;
+    scheduler.setIntervalTrace(trace);
+    
+    // Cargar procesos desde archivo
+    if (!scheduler.loadProcessesFromFile(inputFile)) {
+        cout << "Error cargando el archivo de entrada." << endl;
+        return 1;
+    }
+    
+    // Ejecutar simulación
+    scheduler.simulate();
+    
+    // Mostrar resultados
+    scheduler.printResults();
+    
+    // Guardar resultados
+    scheduler.saveResultsToFile(outputFile);
+    saveResultColumns(scheduler.getFinishedProcesses(), columnsFile);
+    saveSchedulerStats(scheduler, statsFile, cout);
+    finishIntervalTrace(trace, traceFile, cout);
+    
+    return 0;
+}
\ No newline at end of file
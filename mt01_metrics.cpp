@@ -0,0 +1,168 @@
+#include "mt01.h"
+
+// ---- LatencyHistogram ----
+
+// Valores menores que 2^(SUB_BITS+1) tienen cubeta exacta; por encima, cada
+// potencia de 2 se parte en 2^SUB_BITS cubetas (error relativo < 1/32).
+static const int HIST_SUB_BITS = 5;
+static const int HIST_SUB_COUNT = 1 << HIST_SUB_BITS;
+static const int HIST_EXACT = HIST_SUB_COUNT * 2;
+static const int HIST_BUCKETS = HIST_EXACT + (63 - (HIST_SUB_BITS + 1)) * HIST_SUB_COUNT;
+
+static int highestBit(unsigned long long v) {
+    int bit = 0;
+    while (v >>= 1) bit++;
+    return bit;
+}
+
+LatencyHistogram::LatencyHistogram()
+    : buckets(HIST_BUCKETS, 0), total(0), minValue(0), maxValue(0) {}
+
+int LatencyHistogram::bucketOf(long long value) {
+    if (value < HIST_EXACT) return value < 0 ? 0 : (int)value;
+    int exponent = highestBit((unsigned long long)value);
+    int sub = (int)((value >> (exponent - HIST_SUB_BITS)) & (HIST_SUB_COUNT - 1));
+    return HIST_EXACT + (exponent - (HIST_SUB_BITS + 1)) * HIST_SUB_COUNT + sub;
+}
+
+// Mayor valor que cae en la cubeta
+long long LatencyHistogram::bucketUpperBound(int bucket) {
+    if (bucket < HIST_EXACT) return bucket;
+    int exponent = (bucket - HIST_EXACT) / HIST_SUB_COUNT + (HIST_SUB_BITS + 1);
+    long long sub = (bucket - HIST_EXACT) % HIST_SUB_COUNT;
+    long long width = 1LL << (exponent - HIST_SUB_BITS);
+    return ((HIST_SUB_COUNT + sub) << (exponent - HIST_SUB_BITS)) + width - 1;
+}
+
+void LatencyHistogram::record(long long value) {
+    if (total == 0 || value < minValue) minValue = value;
+    if (total == 0 || value > maxValue) maxValue = value;
+    buckets[bucketOf(value)]++;
+    total++;
+}
+
+// Como 'weight' llamadas a record(value); sirve para muestras ponderadas
+// por tiempo (el percentil queda en unidades de tiempo)
+void LatencyHistogram::record(long long value, long long weight) {
+    if (weight <= 0) return;
+    if (total == 0 || value < minValue) minValue = value;
+    if (total == 0 || value > maxValue) maxValue = value;
+    buckets[bucketOf(value)] += weight;
+    total += weight;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other.total == 0) return;
+    if (total == 0 || other.minValue < minValue) minValue = other.minValue;
+    if (total == 0 || other.maxValue > maxValue) maxValue = other.maxValue;
+    for (int i = 0; i < HIST_BUCKETS; i++) buckets[i] += other.buckets[i];
+    total += other.total;
+}
+
+// Percentil p (0..1): cota superior de la cubeta, acotada por el maximo real
+long long LatencyHistogram::percentile(double p) const {
+    if (total == 0) return 0;
+    long long rank = (long long)(p * total);
+    if (rank < p * total) rank++;
+    if (rank < 1) rank = 1;
+    long long seen = 0;
+    for (int i = 0; i < HIST_BUCKETS; i++) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            long long bound = bucketUpperBound(i);
+            if (bound > maxValue) bound = maxValue;
+            if (bound < minValue) bound = minValue;
+            return bound;
+        }
+    }
+    return maxValue;
+}
+
+long long LatencyHistogram::count() const { return total; }
+long long LatencyHistogram::getMin() const { return minValue; }
+long long LatencyHistogram::getMax() const { return maxValue; }
+
+// ---- MetricsSummary ----
+
+MetricsSummary::MetricsSummary()
+    : count(0), totalWT(0), totalCT(0), totalRT(0), totalTAT(0), totalIO(0) {}
+
+void MetricsSummary::record(const Process& p) {
+    record(p.getWaitingTime(), p.getCompletionTime(), p.getResponseTime(), p.getTurnaroundTime(),
+           p.getIoTime());
+}
+
+void MetricsSummary::record(long long wt, long long ct, long long rt, long long tat, long long io) {
+    count++;
+    totalWT += wt;
+    totalCT += ct;
+    totalRT += rt;
+    totalTAT += tat;
+    totalIO += io;
+    waiting.record(wt);
+    response.record(rt);
+    turnaround.record(tat);
+}
+
+void MetricsSummary::merge(const MetricsSummary& other) {
+    count += other.count;
+    totalWT += other.totalWT;
+    totalCT += other.totalCT;
+    totalRT += other.totalRT;
+    totalTAT += other.totalTAT;
+    totalIO += other.totalIO;
+    waiting.merge(other.waiting);
+    response.merge(other.response);
+    turnaround.merge(other.turnaround);
+}
+
+double MetricsSummary::averageWT() const { return count ? (double)totalWT / count : 0; }
+double MetricsSummary::averageCT() const { return count ? (double)totalCT / count : 0; }
+double MetricsSummary::averageRT() const { return count ? (double)totalRT / count : 0; }
+double MetricsSummary::averageTAT() const { return count ? (double)totalTAT / count : 0; }
+double MetricsSummary::averageIO() const { return count ? (double)totalIO / count : 0; }
+
+// ---- MetricsAccumulator ----
+
+MetricsAccumulator::MetricsAccumulator(int levels) : perLevel(levels) {}
+
+void MetricsAccumulator::record(const Process& p, int level) {
+    overall.record(p);
+    if (level >= 0 && level < (int)perLevel.size()) perLevel[level].record(p);
+}
+
+void MetricsAccumulator::record(long long wt, long long ct, long long rt, long long tat, int level) {
+    overall.record(wt, ct, rt, tat);
+    if (level >= 0 && level < (int)perLevel.size()) perLevel[level].record(wt, ct, rt, tat);
+}
+
+void MetricsAccumulator::merge(const MetricsAccumulator& other) {
+    overall.merge(other.overall);
+    if (perLevel.size() < other.perLevel.size()) perLevel.resize(other.perLevel.size());
+    for (int i = 0; i < (int)other.perLevel.size(); i++) perLevel[i].merge(other.perLevel[i]);
+}
+
+const MetricsSummary& MetricsAccumulator::getOverall() const { return overall; }
+const MetricsSummary& MetricsAccumulator::getLevel(int level) const { return perLevel[level]; }
+int MetricsAccumulator::levels() const { return (int)perLevel.size(); }
+
+static void printLatencyRow(const char* name, const LatencyHistogram& h) {
+    printf("  %-4s p50=%lld p90=%lld p99=%lld max=%lld\n", name,
+           h.percentile(0.50), h.percentile(0.90), h.percentile(0.99), h.getMax());
+}
+
+// Percentiles de RT, WT y TAT: global y por cola
+void MetricsAccumulator::printPercentiles() const {
+    cout << "\n=== PERCENTILES ===" << endl;
+    cout << "Global (" << overall.count << " procesos):" << endl;
+    printLatencyRow("RT", overall.response);
+    printLatencyRow("WT", overall.waiting);
+    printLatencyRow("TAT", overall.turnaround);
+    for (int i = 0; i < (int)perLevel.size(); i++) {
+        if (perLevel[i].count == 0) continue;
+        cout << "Cola " << (i + 1) << " (" << perLevel[i].count << " procesos):" << endl;
+        printLatencyRow("RT", perLevel[i].response);
+        printLatencyRow("WT", perLevel[i].waiting);
+        printLatencyRow("TAT", perLevel[i].turnaround);
+    }
+}
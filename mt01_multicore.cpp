@@ -0,0 +1,411 @@
+#include "mt01.h"
+#include <algorithm>
+#include <climits>
+
+// ---- Ubicacion de procesos ----
+
+// Convierte "hash", "least" o "rr" en una politica
+bool parsePlacement(const string& name, PlacementPolicy& policy) {
+    if (name == "hash") policy = PLACE_HASH;
+    else if (name == "least") policy = PLACE_LEAST_LOADED;
+    else if (name == "rr") policy = PLACE_ROUND_ROBIN;
+    else return false;
+    return true;
+}
+
+// FNV-1a: el mismo valor en cualquier plataforma (std::hash no lo garantiza)
+static unsigned int labelHash(const string& label) {
+    unsigned int hash = 2166136261u;
+    for (size_t i = 0; i < label.size(); i++) {
+        hash ^= (unsigned char)label[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Por debajo de estas unidades de trabajo en una fase, las CPUs se simulan
+// en serie (crear los hilos cuesta mas que la fase)
+static const long long PARALLEL_MIN_WORK = 1 << 15;
+
+// ---- MultiCoreScheduler ----
+
+MultiCoreScheduler::MultiCoreScheduler(int schemeNumber, int cpus)
+    : scheme(schemeNumber), arrivalCursor(0), placement(PLACE_LEAST_LOADED), nextPlacement(0),
+      eventDriven(false), jobs(0), retainFinished(true), timeline(make_shared<TimelineSink>()),
+      migrations(0), currentTime(0), ioProcesses(0) {
+    initCores(schemeLevels(scheme), cpus);
+}
+
+MultiCoreScheduler::MultiCoreScheduler(const vector<QueueConfig>& levels, int cpus)
+    : scheme(0), arrivalCursor(0), placement(PLACE_LEAST_LOADED), nextPlacement(0),
+      eventDriven(false), jobs(0), retainFinished(true), timeline(make_shared<TimelineSink>()),
+      migrations(0), currentTime(0), ioProcesses(0) {
+    initCores(levels, cpus);
+}
+
+void MultiCoreScheduler::initCores(const vector<QueueConfig>& levels, int cpus) {
+    levelConfig = levels;
+    cores.assign(max(cpus, 1), CoreState());
+    for (int c = 0; c < (int)cores.size(); c++) {
+        CoreState& core = cores[c];
+        for (int i = 0; i < (int)levels.size(); i++) {
+            core.queues.push_back(ProcessQueue(levels[i].algorithm, levels[i].quantum));
+        }
+        core.hasRunning = false;
+        core.running = core.runningQueue = -1;
+        core.quantumUsed = 0;
+        core.count = 0;
+        core.work = core.busyTime = 0;
+        core.stolenIn = core.stolenOut = 0;
+        core.metrics = MetricsAccumulator((int)levels.size());
+    }
+    metrics = MetricsAccumulator((int)levels.size());
+    setRandomSeed(1);
+}
+
+// Semilla de los sorteos (LOTTERY): una secuencia por CPU y nivel. Con una
+// CPU son las mismas que las de MLFQ_Scheduler.
+void MultiCoreScheduler::setRandomSeed(unsigned long long seed) {
+    int levels = (int)levelConfig.size();
+    for (int c = 0; c < (int)cores.size(); c++) {
+        for (int i = 0; i < levels; i++)
+            cores[c].queues[i].setSeed(seed + (unsigned long long)(c * levels + i) * 0x632BE59BD9B4E019ULL);
+    }
+}
+
+// Las rafagas de E/S no se modelan con varias CPUs: un proceso con E/S se
+// guarda igual, pero simulate() no corre (ver ioProcesses)
+int MultiCoreScheduler::addProcess(const Process& p) {
+    int handle = (int)allProcesses.size();
+    allProcesses.push_back(p);
+    if (p.hasIo()) ioProcesses++;
+    int level = p.getQueueLevel() - 1;
+    if (level < 0 || level >= (int)levelConfig.size()) level = 0;
+    runStates.push_back(makeRunState(allProcesses.back(), level));
+    queueLinks.push_back(makeQueueLink(p));
+    pendingArrivals.push_back(handle);
+    return handle;
+}
+
+bool MultiCoreScheduler::loadProcessesFromFile(const string& filename, int loadThreads, bool echo) {
+    vector<Process> loaded;
+    if (!loadProcessList(filename, loadThreads, echo, loaded)) return false;
+    allProcesses.reserve(allProcesses.size() + loaded.size());
+    runStates.reserve(runStates.size() + loaded.size());
+    queueLinks.reserve(queueLinks.size() + loaded.size());
+    pendingArrivals.reserve(pendingArrivals.size() + loaded.size());
+    for (size_t i = 0; i < loaded.size(); i++) addProcess(loaded[i]);
+    return true;
+}
+
+void MultiCoreScheduler::loadTrace(const ProcessTrace& trace) {
+    const vector<Process>& procs = trace.getProcesses();
+    for (int i = 0; i < (int)procs.size(); i++) addProcess(procs[i]);
+}
+
+int MultiCoreScheduler::chooseCore(int handle) {
+    int n = (int)cores.size();
+    switch (placement) {
+        case PLACE_HASH:
+            return (int)(labelHash(allProcesses[handle].getLabel()) % (unsigned int)n);
+        case PLACE_ROUND_ROBIN: {
+            int core = nextPlacement;
+            nextPlacement = (nextPlacement + 1) % n;
+            return core;
+        }
+        case PLACE_LEAST_LOADED:
+        default: {
+            int best = 0;
+            for (int c = 1; c < n; c++) {
+                if (cores[c].work < cores[best].work) best = c;
+            }
+            return best;
+        }
+    }
+}
+
+void MultiCoreScheduler::assign(int core, int handle, int level) {
+    CoreState& target = cores[core];
+    target.queues[level].addProcess(handle, runStates[handle].remaining);
+    target.count++;
+    target.work += runStates[handle].remaining;
+}
+
+// Cada CPU sin procesos roba uno a la CPU cuyo nivel no vacio mas alto (sin
+// contar su proceso en ejecucion) tenga mayor prioridad; a igual nivel, a la
+// que tenga mas procesos. La victima conserva al menos un proceso.
+void MultiCoreScheduler::stealForIdleCores() {
+    int n = (int)cores.size();
+    for (int thief = 0; thief < n; thief++) {
+        if (cores[thief].count > 0) continue;
+
+        int victim = -1, victimLevel = INT_MAX, candidate = -1;
+        for (int v = 0; v < n; v++) {
+            CoreState& core = cores[v];
+            if (v == thief || core.count < 2) continue;
+            int exclude = core.hasRunning ? core.running : -1;
+            for (int l = 0; l < (int)core.queues.size() && l <= victimLevel; l++) {
+                int h = core.queues[l].lastProcess(exclude);
+                if (h < 0) continue;
+                if (l < victimLevel || core.count > cores[victim].count) {
+                    victim = v;
+                    victimLevel = l;
+                    candidate = h;
+                }
+                break;
+            }
+        }
+        if (victim < 0) return;   // Nadie tiene procesos de sobra
+
+        CoreState& from = cores[victim];
+        from.queues[victimLevel].removeProcess(candidate);
+        from.count--;
+        from.work -= runStates[candidate].remaining;
+        from.stolenOut++;
+        assign(thief, candidate, victimLevel);
+        cores[thief].stolenIn++;
+        migrations++;
+    }
+}
+
+// Boost en cada CPU (como MLFQ_Scheduler::boostAll)
+void MultiCoreScheduler::boostAll() {
+    for (int c = 0; c < (int)cores.size(); c++) {
+        CoreState& core = cores[c];
+        if (core.hasRunning && core.runningQueue > 0) {
+            core.queues[core.runningQueue].updateRemaining(core.running, runStates[core.running].remaining);
+            core.hasRunning = false;
+            core.quantumUsed = 0;
+        }
+        for (int i = 1; i < (int)core.queues.size(); i++) core.queues[0].appendAll(core.queues[i]);
+    }
+}
+
+// Simula una CPU desde currentTime hasta 'until' con las mismas reglas que
+// MLFQ_Scheduler::simulate(). En ese intervalo no hay llegadas ni robos, asi
+// que solo toca sus propias colas y los procesos asignados a ella.
+void MultiCoreScheduler::runCore(int c, SimTime until) {
+    CoreState& core = cores[c];
+    vector<ProcessQueue>& queues = core.queues;
+    SimTime time = currentTime;
+
+    while (time < until && core.count > 0) {
+        // Preempcion por un nivel de mayor prioridad
+        if (core.hasRunning) {
+            for (int i = 0; i < core.runningQueue; i++) {
+                if (!queues[i].isEmpty()) {
+                    queues[core.runningQueue].updateRemaining(core.running, runStates[core.running].remaining);
+                    core.hasRunning = false;
+                    core.quantumUsed = 0;
+                    break;
+                }
+            }
+        }
+
+        // STCF y PRIORITY: re-evaluar dentro de la cola
+        if (core.hasRunning && queues[core.runningQueue].preemptsWithin()) {
+            int candidate = queues[core.runningQueue].getNextProcess(time);
+            if (candidate != core.running) {
+                queues[core.runningQueue].updateRemaining(core.running, runStates[core.running].remaining);
+                core.running = candidate;
+                core.quantumUsed = 0;
+            }
+        }
+
+        if (!core.hasRunning) {
+            for (int i = 0; i < (int)queues.size(); i++) {
+                if (!queues[i].isEmpty()) {
+                    core.running = queues[i].getNextProcess(time);
+                    core.runningQueue = i;
+                    core.hasRunning = true;
+                    core.quantumUsed = 0;
+                    break;
+                }
+            }
+        }
+
+        int running = core.running;
+        RunState& state = runStates[running];
+        if (!state.started) {
+            allProcesses[running].setResponseTime(time - state.arrival);
+            state.started = 1;
+        }
+
+        ProcessQueue& queue = queues[core.runningQueue];
+        bool quantum = queue.usesQuantum();
+        SimTime timeSlice = 1;
+        if (eventDriven) {
+            timeSlice = state.remaining;
+            if (quantum) timeSlice = min(timeSlice, (SimTime)(queue.getQuantum() - core.quantumUsed));
+            timeSlice = min(timeSlice, until - time);
+            if (timeSlice < 1) timeSlice = 1;
+        }
+        time += timeSlice;
+        state.remaining -= timeSlice;
+        core.work -= timeSlice;
+        core.busyTime += timeSlice;
+        if (quantum) core.quantumUsed += (int)timeSlice;
+
+        if (state.remaining == 0) {
+            Process& p = allProcesses[running];
+            p.setCompletionTime(time);
+            p.calculateMetrics();
+            core.metrics.record(p, core.runningQueue);
+            if (retainFinished) core.finished.push_back(running);
+            queue.removeProcess(running);
+            core.count--;
+            core.hasRunning = false;
+            core.quantumUsed = 0;
+        } else if (quantum && core.quantumUsed == queue.getQuantum()) {
+            int nextQ = core.runningQueue;
+            if (feedback.demoteOnExpiry && nextQ + 1 < (int)queues.size()) nextQ++;
+            if (nextQ == core.runningQueue) {
+                queue.rotate(running, state.remaining);
+            } else {
+                queue.removeProcess(running);
+                queues[nextQ].addProcess(running, state.remaining);
+            }
+            core.hasRunning = false;
+            core.quantumUsed = 0;
+        } else {
+            queue.updateRemaining(running, state.remaining);
+        }
+    }
+}
+
+// false sin simular si algun proceso tiene rafagas de E/S: correr solo su CPU
+// daria metricas de otra carga
+bool MultiCoreScheduler::simulate() {
+    if (ioProcesses > 0) return false;
+    if (timeline->getLevel() >= TIMELINE_SUMMARY) {
+        timeline->summary("Iniciando simulacion MLFQ - " +
+                          (scheme > 0 ? "Esquema " + to_string(scheme) : describeLevels(levelConfig)) +
+                          " en " + to_string(cores.size()) + " CPUs" +
+                          (feedback.demoteOnExpiry || feedback.boostPeriod > 0
+                               ? " [" + describeFeedback(feedback) + "]" : "") +
+                          (eventDriven ? " (motor por eventos)" : ""));
+    }
+    // Orden de llegada estable; las colas RR abren su tramo de sellos antes
+    // de que las CPUs corran en paralelo
+    SimTime now = currentTime;
+    const vector<RunState>& states = runStates;
+    stable_sort(pendingArrivals.begin() + arrivalCursor, pendingArrivals.end(),
+                [&states, now](int a, int b) {
+                    return max(states[a].arrival, now) < max(states[b].arrival, now);
+                });
+    for (int c = 0; c < (int)cores.size(); c++) {
+        for (int i = 0; i < (int)cores[c].queues.size(); i++) {
+            cores[c].queues[i].bindLinks(&queueLinks, &stampOffsets);
+            cores[c].queues[i].reserve(0);
+        }
+    }
+
+    SimTime boostPeriod = feedback.boostPeriod;
+    SimTime nextBoost = boostPeriod > 0 ? (currentTime / boostPeriod + 1) * boostPeriod : -1;
+    vector<int> active;
+    int threads = resolveThreadCount(jobs);
+
+    while (true) {
+        // Llegadas: cada una a la CPU que indique la politica
+        while (arrivalCursor < (int)pendingArrivals.size()) {
+            int handle = pendingArrivals[arrivalCursor];
+            if (runStates[handle].arrival > currentTime) break;
+            assign(chooseCore(handle), handle, runStates[handle].level);
+            arrivalCursor++;
+        }
+
+        if (nextBoost >= 0 && currentTime >= nextBoost) {
+            boostAll();
+            nextBoost = (currentTime / boostPeriod + 1) * boostPeriod;
+        }
+
+        stealForIdleCores();
+
+        // Fin de la fase: la proxima llegada, el proximo boost o el momento
+        // en que alguna CPU termina todo su trabajo (entonces puede robar)
+        long long horizon = LLONG_MAX;
+        if (arrivalCursor < (int)pendingArrivals.size())
+            horizon = runStates[pendingArrivals[arrivalCursor]].arrival;
+        active.clear();
+        long long phaseWork = 0;
+        for (int c = 0; c < (int)cores.size(); c++) {
+            if (cores[c].count == 0) continue;
+            active.push_back(c);
+            horizon = min(horizon, currentTime + cores[c].work);
+        }
+        if (active.empty()) {
+            if (horizon == LLONG_MAX) break;
+            currentTime = (SimTime)horizon;
+            if (nextBoost >= 0 && nextBoost < currentTime)
+                nextBoost = (currentTime + boostPeriod - 1) / boostPeriod * boostPeriod;
+            continue;
+        }
+        if (nextBoost >= 0) horizon = min(horizon, (long long)nextBoost);
+        SimTime until = (SimTime)horizon;
+        for (int i = 0; i < (int)active.size(); i++) phaseWork += until - currentTime;
+
+        if (threads > 1 && active.size() > 1 && phaseWork >= PARALLEL_MIN_WORK) {
+            parallelFor((int)active.size(), threads, [&](int i) { runCore(active[i], until); });
+        } else {
+            for (int i = 0; i < (int)active.size(); i++) runCore(active[i], until);
+        }
+        currentTime = until;
+    }
+
+    collectResults();
+    if (timeline->getLevel() >= TIMELINE_SUMMARY)
+        timeline->summary("Simulacion completada en tiempo: " + to_string(currentTime));
+    timeline->flush();
+    return true;
+}
+
+// Une las metricas de todas las CPUs y ordena los terminados por CT (a
+// igual CT, por numero de CPU)
+void MultiCoreScheduler::collectResults() {
+    metrics = MetricsAccumulator((int)levelConfig.size());
+    vector<int> handles;
+    for (int c = 0; c < (int)cores.size(); c++) {
+        metrics.merge(cores[c].metrics);
+        handles.insert(handles.end(), cores[c].finished.begin(), cores[c].finished.end());
+    }
+    const vector<Process>& procs = allProcesses;
+    stable_sort(handles.begin(), handles.end(), [&procs](int a, int b) {
+        return procs[a].getCompletionTime() < procs[b].getCompletionTime();
+    });
+    finishedProcesses.clear();
+    finishedProcesses.reserve(handles.size());
+    for (int i = 0; i < (int)handles.size(); i++) finishedProcesses.push_back(allProcesses[handles[i]]);
+}
+
+void MultiCoreScheduler::saveResultsToFile(const string& filename) {
+    writeResultsFile(filename, finishedProcesses, metrics);
+}
+
+void MultiCoreScheduler::printResults() {
+    printResultsTable(finishedProcesses, metrics);
+
+    cout << "\n=== CPUS ===" << endl;
+    cout << "CPU\tOcupada\tUtil.\tProcesos\tRobados\tCedidos" << endl;
+    for (int c = 0; c < (int)cores.size(); c++) {
+        const CoreState& core = cores[c];
+        double utilization = currentTime > 0 ? 100.0 * core.busyTime / currentTime : 0;
+        printf("%d\t%lld\t%.1f%%\t%lld\t\t%d\t%d\n", c, core.busyTime, utilization,
+               core.metrics.getOverall().count, core.stolenIn, core.stolenOut);
+    }
+    cout << "Migraciones: " << migrations << endl;
+}
+
+void MultiCoreScheduler::setPlacement(PlacementPolicy policy) { placement = policy; }
+void MultiCoreScheduler::setFeedback(const FeedbackConfig& rules) { feedback = rules; }
+void MultiCoreScheduler::setEventDriven(bool enabled) { eventDriven = enabled; }
+void MultiCoreScheduler::setJobs(int threads) { jobs = threads; }
+void MultiCoreScheduler::setRetainFinished(bool enabled) { retainFinished = enabled; }
+void MultiCoreScheduler::setTimeline(shared_ptr<TimelineSink> sink) { timeline = sink; }
+
+SimTime MultiCoreScheduler::getCurrentTime() const { return currentTime; }
+int MultiCoreScheduler::cpuCount() const { return (int)cores.size(); }
+int MultiCoreScheduler::ioProcessCount() const { return ioProcesses; }
+const CoreState& MultiCoreScheduler::getCore(int core) const { return cores[core]; }
+long long MultiCoreScheduler::getMigrations() const { return migrations; }
+const vector<Process>& MultiCoreScheduler::getFinishedProcesses() const { return finishedProcesses; }
+const MetricsAccumulator& MultiCoreScheduler::getMetrics() const { return metrics; }
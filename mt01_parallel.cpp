@@ -0,0 +1,28 @@
+#include "mt01.h"
+#include <atomic>
+#include <thread>
+
+// ---- Ejecucion en paralelo ----
+
+int resolveThreadCount(int threads) {
+    if (threads <= 0) threads = (int)thread::hardware_concurrency();
+    return threads > 0 ? threads : 1;
+}
+
+// Los hilos toman el siguiente indice libre de un contador compartido, asi
+// las tareas largas no dejan hilos ociosos esperando un reparto fijo
+void parallelFor(int count, int threads, const function<void(int)>& task) {
+    threads = min(resolveThreadCount(threads), count);
+    if (threads <= 1) {
+        for (int i = 0; i < count; i++) task(i);
+        return;
+    }
+    atomic<int> next(0);
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.push_back(thread([&]() {
+            for (int i = next++; i < count; i = next++) task(i);
+        }));
+    }
+    for (int t = 0; t < threads; t++) workers[t].join();
+}
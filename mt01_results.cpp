@@ -0,0 +1,179 @@
+#include "mt01.h"
+#include <charconv>
+#include <cstring>
+#include <limits>
+
+// ---- Escritura rapida del .out ----
+
+// Lo que sigue a la etiqueta en una linea "etiqueta;BT;AT;Q;Pr;WT;CT;RT;TAT",
+// con los mismos bytes que el fprintf de siempre; devuelve el fin. Cada
+// numero ocupa a lo sumo sus digitos, el signo y el ';'.
+static const int RESULT_NUMBERS_BYTES = 8 * (numeric_limits<SimTime>::digits10 + 3) + 1;
+
+static char* formatResultNumbers(char* digits, const Process& p) {
+    const SimTime values[8] = { p.getBurstTime(), p.getArrivalTime(), p.getQueueLevel(), p.getPriority(),
+                            p.getWaitingTime(), p.getCompletionTime(), p.getResponseTime(),
+                            p.getTurnaroundTime() };
+    char* cursor = digits;
+    for (int i = 0; i < 8; i++) {
+        *cursor++ = ';';
+        cursor = to_chars(cursor, digits + RESULT_NUMBERS_BYTES, values[i]).ptr;
+    }
+    *cursor++ = '\n';
+    return cursor;
+}
+
+void appendResultLine(string& out, const Process& p) {
+    char digits[RESULT_NUMBERS_BYTES];
+    char* end = formatResultNumbers(digits, p);
+    out += p.getLabel();
+    out.append(digits, end - digits);
+}
+
+// Una linea del .out por proceso terminado
+void writeResultLine(FILE* file, const Process& p) {
+    char digits[RESULT_NUMBERS_BYTES];
+    char* end = formatResultNumbers(digits, p);
+    const string& label = p.getLabel();
+    fwrite(label.data(), 1, label.size(), file);
+    fwrite(digits, 1, end - digits, file);
+}
+
+// Lineas por bloque: cada hilo arma un bloque en su buffer
+static const int RESULT_CHUNK_LINES = 1 << 15;
+
+// Los bloques se arman de a 'threads' en paralelo y se escriben en orden
+// antes de armar los siguientes, asi la memoria no crece con la corrida
+void writeResultLines(FILE* file, const vector<Process>& finished, int threads) {
+    int count = (int)finished.size();
+    int chunks = (count + RESULT_CHUNK_LINES - 1) / RESULT_CHUNK_LINES;
+    int group = min(resolveThreadCount(threads), max(chunks, 1));
+    vector<string> buffers(group);
+    for (int firstChunk = 0; firstChunk < chunks; firstChunk += group) {
+        int batch = min(group, chunks - firstChunk);
+        parallelFor(batch, batch, [&](int b) {
+            int begin = (firstChunk + b) * RESULT_CHUNK_LINES;
+            int end = min(count, begin + RESULT_CHUNK_LINES);
+            string& buffer = buffers[b];
+            buffer.clear();
+            for (int i = begin; i < end; i++) appendResultLine(buffer, finished[i]);
+        });
+        for (int b = 0; b < batch; b++) fwrite(buffers[b].data(), 1, buffers[b].size(), file);
+    }
+}
+
+// ---- Salida columnar ----
+
+// Cabecera de 48 bytes: firma, version, orden de bytes (como los checkpoints,
+// el archivo es para la misma plataforma), filas, columnas, etiquetas
+// distintas, posicion del diccionario y bytes por valor (4, o 8 compilando
+// con MLFQ_TIME64). Despues una tabla de columnas (nombre de 8 bytes y
+// posicion) y cada columna: un entero con signo por proceso, en el orden
+// del .out. El diccionario son 'labels' + 1 posiciones (uint64,
+// relativas al texto) y el texto de las etiquetas seguido. Todo lo que se
+// lee como numero queda alineado a 8 bytes, asi que se puede mapear.
+static const char COLUMNS_MAGIC[8] = { 'M', 'L', 'F', 'Q', 'C', 'O', 'L', 'S' };
+static const int COLUMNS_VERSION = 2;
+static const int COLUMNS_BYTE_ORDER = 0x01020304;
+static const int COLUMNS_HEADER_BYTES = 48;
+static const int COLUMNS_BLOCK = 1 << 16;
+
+static const char* const COLUMN_NAMES[] = { "label", "BT", "AT", "Q", "Pr", "WT", "CT", "RT", "TAT", "IO" };
+static const int COLUMN_COUNT = sizeof(COLUMN_NAMES) / sizeof(COLUMN_NAMES[0]);
+
+static SimTime columnValue(const Process& p, int column) {
+    switch (column) {
+        case 1: return p.getBurstTime();
+        case 2: return p.getArrivalTime();
+        case 3: return p.getQueueLevel();
+        case 4: return p.getPriority();
+        case 5: return p.getWaitingTime();
+        case 6: return p.getCompletionTime();
+        case 7: return p.getResponseTime();
+        case 8: return p.getTurnaroundTime();
+        default: return p.getIoTime();
+    }
+}
+
+static unsigned long long alignTo8(unsigned long long value) {
+    return (value + 7) & ~7ULL;
+}
+
+bool writeResultColumns(const string& filename, const vector<Process>& finished) {
+    FILE* file = fopen(filename.c_str(), "wb");
+    if (file == NULL) {
+        cout << "Error: No se pudo crear el archivo " << filename << endl;
+        return false;
+    }
+
+    // Diccionario local: las etiquetas en el orden en que aparecen
+    unsigned long long rows = finished.size();
+    vector<int> localId(LabelTable::size(), -1);
+    vector<int> dictionary;
+    for (size_t i = 0; i < finished.size(); i++) {
+        int id = finished[i].getLabelId();
+        if (localId[id] >= 0) continue;
+        localId[id] = (int)dictionary.size();
+        dictionary.push_back(id);
+    }
+
+    unsigned long long tableBytes = COLUMN_COUNT * 16ULL;
+    unsigned long long columnBytes = alignTo8(rows * sizeof(SimTime));
+    unsigned long long firstColumn = COLUMNS_HEADER_BYTES + tableBytes;
+    unsigned long long dictionaryOffset = firstColumn + COLUMN_COUNT * columnBytes;
+
+    bool ok = true;
+    auto put = [&](const void* data, size_t size) {
+        if (ok && size > 0 && fwrite(data, 1, size, file) != size) ok = false;
+    };
+    int columns = COLUMN_COUNT, labels = (int)dictionary.size(), width = (int)sizeof(SimTime), reserved = 0;
+    put(COLUMNS_MAGIC, sizeof(COLUMNS_MAGIC));
+    put(&COLUMNS_VERSION, sizeof(int));
+    put(&COLUMNS_BYTE_ORDER, sizeof(int));
+    put(&rows, sizeof(rows));
+    put(&columns, sizeof(int));
+    put(&labels, sizeof(int));
+    put(&dictionaryOffset, sizeof(dictionaryOffset));
+    put(&width, sizeof(int));
+    put(&reserved, sizeof(int));
+    for (int c = 0; c < COLUMN_COUNT; c++) {
+        char name[8] = { 0 };
+        memcpy(name, COLUMN_NAMES[c], strlen(COLUMN_NAMES[c]));
+        unsigned long long offset = firstColumn + c * columnBytes;
+        put(name, sizeof(name));
+        put(&offset, sizeof(offset));
+    }
+
+    static const char padding[8] = { 0 };
+    vector<SimTime> block;
+    block.reserve(COLUMNS_BLOCK);
+    for (int c = 0; c < COLUMN_COUNT; c++) {
+        for (size_t begin = 0; begin < finished.size(); begin += COLUMNS_BLOCK) {
+            size_t end = min(finished.size(), begin + COLUMNS_BLOCK);
+            block.clear();
+            for (size_t i = begin; i < end; i++)
+                block.push_back(c == 0 ? localId[finished[i].getLabelId()] : columnValue(finished[i], c));
+            put(block.data(), block.size() * sizeof(SimTime));
+        }
+        put(padding, columnBytes - rows * sizeof(SimTime));
+    }
+
+    unsigned long long offset = 0;
+    put(&offset, sizeof(offset));
+    for (size_t i = 0; i < dictionary.size(); i++) {
+        offset += LabelTable::name(dictionary[i]).size();
+        put(&offset, sizeof(offset));
+    }
+    for (size_t i = 0; i < dictionary.size(); i++) {
+        const string& name = LabelTable::name(dictionary[i]);
+        put(name.data(), name.size());
+    }
+    if (fclose(file) != 0) ok = false;
+    if (!ok) {
+        cout << "Error: No se pudo escribir el archivo " << filename << endl;
+        return false;
+    }
+    cout << "Columnas guardadas en: " << filename << " (" << rows << " procesos, "
+         << dictionary.size() << " etiquetas)" << endl;
+    return true;
+}
@@ -0,0 +1,87 @@
+#include "mt01_static.h"
+#include <chrono>
+
+// ---- Instanciaciones de los esquemas predefinidos ----
+
+typedef MLFQ<policy::RR<1>, policy::RR<3>, policy::RR<4>, policy::SJF> Scheme1;
+typedef MLFQ<policy::RR<2>, policy::RR<3>, policy::RR<4>, policy::STCF> Scheme2;
+typedef MLFQ<policy::RR<3>, policy::RR<5>, policy::RR<6>, policy::RR<20> > Scheme3;
+
+bool runStaticScheme(int scheme, const ProcessTrace& trace, StaticRunResult& result, bool keepOrder) {
+    if (trace.hasIo()) return false;   // El motor especializado solo simula CPU
+    switch (scheme) {
+        case 1: { Scheme1 engine(trace); engine.run(result, keepOrder); return true; }
+        case 2: { Scheme2 engine(trace); engine.run(result, keepOrder); return true; }
+        case 3: { Scheme3 engine(trace); engine.run(result, keepOrder); return true; }
+        default: return false;
+    }
+}
+
+int matchBuiltInScheme(const vector<QueueConfig>& levels) {
+    for (int scheme = 1; scheme <= 3; scheme++) {
+        vector<QueueConfig> builtIn = schemeLevels(scheme);
+        if (builtIn.size() != levels.size()) continue;
+        bool same = true;
+        for (size_t i = 0; i < levels.size() && same; i++) {
+            same = builtIn[i].algorithm == levels[i].algorithm &&
+                   (levels[i].algorithm != ROUND_ROBIN || builtIn[i].quantum == levels[i].quantum);
+        }
+        if (same) return scheme;
+    }
+    return 0;
+}
+
+// ---- Benchmark: especializado vs. configurado en tiempo de ejecucion ----
+
+static double elapsedMs(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+static bool sameSummary(const MetricsSummary& a, const MetricsSummary& b) {
+    return a.count == b.count && a.totalWT == b.totalWT && a.totalCT == b.totalCT &&
+           a.totalRT == b.totalRT && a.totalTAT == b.totalTAT;
+}
+
+// Corre cada esquema 'repeats' veces con ambos motores (motor por eventos,
+// sin timeline) y muestra el mejor tiempo de cada uno y la aceleracion
+void runPolicyBenchmark(const ProcessTrace& trace, int repeats) {
+    if (repeats < 1) repeats = 1;
+    if (trace.hasIo()) {
+        cout << "Error: la entrada tiene rafagas de E/S; el motor especializado solo simula CPU" << endl;
+        return;
+    }
+    cout << "Benchmark de politicas: " << trace.size() << " procesos, mejor de "
+         << repeats << " corridas" << endl;
+    printf("%-8s %12s %12s %9s  %s\n", "esquema", "dinamico_ms", "estatico_ms", "speedup", "resultados");
+
+    for (int scheme = 1; scheme <= 3; scheme++) {
+        double bestDynamic = -1, bestStatic = -1;
+        MetricsSummary dynamicSummary;
+        SimTime dynamicMakespan = 0;
+        StaticRunResult staticResult;
+
+        for (int r = 0; r < repeats; r++) {
+            MLFQ_Scheduler scheduler(schemeLevels(scheme));
+            scheduler.setEventDriven(true);
+            scheduler.setRetainFinished(false);
+            scheduler.setTimeline(make_shared<TimelineSink>(TIMELINE_OFF));
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            scheduler.loadTrace(trace);
+            scheduler.simulate();
+            double ms = elapsedMs(start);
+            if (bestDynamic < 0 || ms < bestDynamic) bestDynamic = ms;
+            dynamicSummary = scheduler.getMetrics().getOverall();
+            dynamicMakespan = scheduler.getCurrentTime();
+
+            start = chrono::steady_clock::now();
+            runStaticScheme(scheme, trace, staticResult);
+            ms = elapsedMs(start);
+            if (bestStatic < 0 || ms < bestStatic) bestStatic = ms;
+        }
+
+        bool same = sameSummary(dynamicSummary, staticResult.metrics.getOverall()) &&
+                    dynamicMakespan == staticResult.makespan;
+        printf("%-8d %12.2f %12.2f %8.2fx  %s\n", scheme, bestDynamic, bestStatic,
+               bestStatic > 0 ? bestDynamic / bestStatic : 0.0, same ? "iguales" : "DISTINTOS");
+    }
+}
@@ -0,0 +1,238 @@
+#ifndef MT01_STATIC_H
+#define MT01_STATIC_H
+
+#include "mt01.h"
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include <algorithm>
+
+// Motor MLFQ especializado en tiempo de compilacion. Cada nivel es un tipo de
+// politica (policy::RR<Q>, policy::SJF, policy::STCF) y el scheduler se
+// instancia sobre la lista de niveles, por ejemplo
+//
+//     MLFQ<policy::RR<2>, policy::RR<3>, policy::RR<4>, policy::STCF>
+//
+// Sin switch por algoritmo ni getAlgorithm() en el bucle: quantum, rotacion y
+// preempcion de cada nivel son constantes del tipo. Las colas son las mismas
+// ProcessQueue de MLFQ_Scheduler (una sola lista RR y un solo monticulo), asi
+// que las decisiones coinciden con las del motor por eventos (mismo .out,
+// mismas metricas).
+
+namespace policy {
+
+// Un nivel con algoritmo y quantum fijos sobre una ProcessQueue; la seleccion
+// llama directo a la rutina del algoritmo, sin pasar por getNextProcess
+template <SchedulingAlgorithm Algorithm, int Q>
+class Level {
+public:
+    static const bool roundRobin = Algorithm == ROUND_ROBIN;
+    static const bool preemptive = Algorithm == ::STCF;
+    static const int quantum = Q;
+
+    Level() : queue(Algorithm, Q) {}
+    void bind(vector<QueueLink>* links, vector<long long>* offsets, int processes) {
+        queue.bindLinks(links, offsets);
+        queue.reserve(processes);
+    }
+    bool empty() const { return queue.isEmpty(); }
+    void add(int h, SimTime remaining) { queue.addProcess(h, remaining); }
+
+    int select() {
+        if (Algorithm == ROUND_ROBIN) return queue.roundRobin(0);
+        if (Algorithm == ::STCF) return queue.shortestTimeToCompletion(0);
+        return queue.shortestJobFirst(0);
+    }
+
+    void remove(int h) { queue.removeProcess(h); }
+
+    // RR no ordena por restante: no hay nada que marcar
+    void update(int h, SimTime remaining) {
+        if (!roundRobin) queue.updateRemaining(h, remaining);
+    }
+
+private:
+    ProcessQueue queue;
+};
+
+// Round Robin con quantum Q
+template <int Q>
+using RR = Level<ROUND_ROBIN, Q>;
+
+// Monticulo por (restante al ultimo orden, sello); STCF reordena en cada
+// seleccion, SJF solo al insertar
+typedef Level<::SJF, 0> SJF;
+typedef Level<::STCF, 0> STCF;
+
+} // namespace policy
+
+// Resultado de una corrida del motor especializado
+struct StaticRunResult {
+    MetricsAccumulator metrics;
+    SimTime makespan;
+    vector<int> completionOrder;   // indices de la traza en orden de finalizacion
+};
+
+template <class... Levels>
+class MLFQ {
+public:
+    static const int LEVELS = sizeof...(Levels);
+
+    explicit MLFQ(const ProcessTrace& t) : trace(t) {}
+
+    void run(StaticRunResult& result, bool keepOrder = false) {
+        const vector<Process>& procs = trace.getProcesses();
+        const vector<int>& order = trace.getArrivalOrder();
+        int n = (int)procs.size();
+
+        // Estado caliente en arreglos contiguos
+        vector<SimTime> arrival(n), burst(n), remaining(n), response(n);
+        vector<int> level(n);
+        vector<char> started(n, 0);
+        for (int i = 0; i < n; i++) {
+            arrival[i] = procs[i].getArrivalTime();
+            burst[i] = procs[i].getBurstTime();
+            remaining[i] = burst[i];
+            int q = procs[i].getQueueLevel() - 1;
+            level[i] = (q >= 0 && q < LEVELS) ? q : 0;
+        }
+        queues = std::tuple<Levels...>();
+        links.assign(n, QueueLink());
+        stampOffsets.clear();
+        bindAll(n, std::index_sequence_for<Levels...>());
+
+        result.metrics = MetricsAccumulator(LEVELS);
+        result.completionOrder.clear();
+        if (keepOrder) result.completionOrder.reserve(n);
+
+        SimTime currentTime = 0;
+        int cursor = 0;
+        int running = -1, runningLevel = -1, quantumUsed = 0;
+
+        while (cursor < n || anyNonEmpty()) {
+            // Llegadas
+            while (cursor < n && arrival[order[cursor]] <= currentTime) {
+                int h = order[cursor++];
+                onLevel(level[h], [&](auto& q) { q.add(h, remaining[h]); });
+            }
+
+            // Preempcion por un nivel de mayor prioridad
+            if (running >= 0 && firstNonEmpty() < runningLevel) {
+                running = -1;
+                quantumUsed = 0;
+            }
+
+            // STCF: re-evaluar dentro del nivel
+            if (running >= 0) {
+                onLevel(runningLevel, [&](auto& q) {
+                    typedef typename std::decay<decltype(q)>::type Level;
+                    if (Level::preemptive) {
+                        int candidate = q.select();
+                        if (candidate != running) {
+                            running = candidate;
+                            quantumUsed = 0;
+                        }
+                    }
+                });
+            }
+
+            // Elegir si no hay proceso en CPU
+            if (running < 0) {
+                int l = firstNonEmpty();
+                if (l >= 0) {
+                    runningLevel = l;
+                    quantumUsed = 0;
+                    onLevel(l, [&](auto& q) { running = q.select(); });
+                }
+            }
+            if (running >= 0 && !started[running]) {
+                started[running] = 1;
+                response[running] = currentTime - arrival[running];
+            }
+
+            SimTime nextArrival = cursor < n ? arrival[order[cursor]] : -1;
+            if (running < 0) {
+                if (nextArrival > currentTime) currentTime = nextArrival;
+                else currentTime++;
+                continue;
+            }
+
+            // Ejecutar hasta el siguiente evento
+            onLevel(runningLevel, [&](auto& q) {
+                typedef typename std::decay<decltype(q)>::type Level;
+                SimTime slice = remaining[running];
+                if (Level::roundRobin) slice = std::min(slice, (SimTime)(Level::quantum - quantumUsed));
+                if (nextArrival >= 0) slice = std::min(slice, nextArrival - currentTime);
+                if (slice < 1) slice = 1;
+                currentTime += slice;
+                remaining[running] -= slice;
+                if (Level::roundRobin) quantumUsed += (int)slice;
+
+                if (remaining[running] == 0) {
+                    SimTime ct = currentTime;
+                    SimTime tat = ct - arrival[running];
+                    result.metrics.record(tat - burst[running], ct, response[running], tat, runningLevel);
+                    if (keepOrder) result.completionOrder.push_back(running);
+                    q.remove(running);
+                    running = -1;
+                    quantumUsed = 0;
+                } else if (Level::roundRobin && quantumUsed == Level::quantum) {
+                    q.remove(running);
+                    q.add(running, remaining[running]);
+                    running = -1;
+                    quantumUsed = 0;
+                } else {
+                    q.update(running, remaining[running]);
+                }
+            });
+        }
+        result.makespan = currentTime;
+    }
+
+private:
+    const ProcessTrace& trace;
+    std::tuple<Levels...> queues;
+    vector<QueueLink> links;
+    vector<long long> stampOffsets;   // Tramos de sellos de las listas RR
+
+    template <size_t... I>
+    void bindAll(int processes, std::index_sequence<I...>) {
+        int dummy[] = { 0, (std::get<I>(queues).bind(&links, &stampOffsets, processes), 0)... };
+        (void)dummy;
+    }
+
+    // Llama a f con el nivel 'index'; se expande a una cadena de if con el
+    // tipo concreto de cada nivel
+    template <size_t I = 0, class F>
+    void onLevel(int index, F&& f) {
+        if constexpr (I < sizeof...(Levels)) {
+            if (index == (int)I) f(std::get<I>(queues));
+            else onLevel<I + 1>(index, f);
+        }
+    }
+
+    template <size_t I = 0>
+    int firstNonEmpty() const {
+        if constexpr (I < sizeof...(Levels)) {
+            if (!std::get<I>(queues).empty()) return (int)I;
+            return firstNonEmpty<I + 1>();
+        } else {
+            return -1;
+        }
+    }
+
+    bool anyNonEmpty() const { return firstNonEmpty() >= 0; }
+};
+
+// Corre la instanciacion especializada del esquema 1, 2 o 3; false si el
+// esquema no tiene una o si la traza tiene rafagas de E/S
+bool runStaticScheme(int scheme, const ProcessTrace& trace, StaticRunResult& result, bool keepOrder = false);
+
+// Esquema predefinido con los mismos niveles (0 si ninguno coincide)
+int matchBuiltInScheme(const vector<QueueConfig>& levels);
+
+// Compara los esquemas 1-3 especializados contra el scheduler configurado en
+// tiempo de ejecucion sobre la misma traza
+void runPolicyBenchmark(const ProcessTrace& trace, int repeats);
+
+#endif
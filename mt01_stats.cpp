@@ -0,0 +1,93 @@
+#include "mt01.h"
+
+// ---- SchedulerStats ----
+
+SchedulerStats::SchedulerStats(int levels)
+    : contextSwitches(0), arrivalPreemptions(0), stcfPreemptions(0), priorityPreemptions(0),
+      rrRotations(0), demotions(0), boosts(0), ioBlocks(0), idleTicks(0), busyTime(levels, 0), depth(levels),
+      depthArea(levels, 0), lastHandle(-1) {
+    for (int i = 0; i < TIMER_COUNT; i++) {
+        timerNanos[i] = 0;
+        timerCalls[i] = 0;
+    }
+}
+
+// 'handle' del nivel 'level' ocupo la CPU 'duration' unidades; las colas no
+// cambian durante la porcion, asi que su largo se pondera por toda ella
+void SchedulerStats::recordRun(const vector<ProcessQueue>& queues, int handle, int level, SimTime duration) {
+    if (duration <= 0) return;
+    if (handle != lastHandle) contextSwitches++;
+    lastHandle = handle;
+    busyTime[level] += duration;
+    for (int i = 0; i < (int)queues.size(); i++) {
+        int size = queues[i].size();
+        depth[i].record(size, duration);
+        depthArea[i] += (long long)size * duration;
+    }
+}
+
+// Sin proceso en CPU todas las colas estan vacias
+void SchedulerStats::recordIdle(SimTime duration) {
+    if (duration <= 0) return;
+    idleTicks += duration;
+    for (int i = 0; i < (int)depth.size(); i++) depth[i].record(0, duration);
+}
+
+static const char* timerName(int timer) {
+    switch (timer) {
+        case TIMER_ARRIVALS: return "check_arrivals";
+        case TIMER_SELECTION: return "selection";
+        default: return "update_in_queue";
+    }
+}
+
+// Volcado JSON: a donde se fue el tiempo simulado (CPU por nivel, ocio,
+// largo de las colas) y el tiempo real (cronometros del bucle)
+bool SchedulerStats::writeJson(const string& filename, const vector<QueueConfig>& levels,
+                               bool eventDriven, SimTime makespan, long long dispatches) const {
+    FILE* file = fopen(filename.c_str(), "w");
+    if (file == NULL) {
+        cout << "Error: No se pudo crear el archivo " << filename << endl;
+        return false;
+    }
+    double span = makespan > 0 ? (double)makespan : 1.0;
+    fprintf(file, "{\n");
+    fprintf(file, "  \"levels\": \"%s\",\n", describeLevels(levels).c_str());
+    fprintf(file, "  \"engine\": \"%s\",\n", eventDriven ? "event" : "tick");
+    fprintf(file, "  \"makespan\": %lld,\n", (long long)makespan);
+    fprintf(file, "  \"dispatches\": %lld,\n", dispatches);
+    fprintf(file, "  \"counters\": {\n");
+    fprintf(file, "    \"context_switches\": %lld,\n", contextSwitches);
+    fprintf(file, "    \"arrival_preemptions\": %lld,\n", arrivalPreemptions);
+    fprintf(file, "    \"stcf_preemptions\": %lld,\n", stcfPreemptions);
+    fprintf(file, "    \"priority_preemptions\": %lld,\n", priorityPreemptions);
+    fprintf(file, "    \"rr_rotations\": %lld,\n", rrRotations);
+    fprintf(file, "    \"demotions\": %lld,\n", demotions);
+    fprintf(file, "    \"boosts\": %lld,\n", boosts);
+    fprintf(file, "    \"io_blocks\": %lld,\n", ioBlocks);
+    fprintf(file, "    \"idle_ticks\": %lld\n", idleTicks);
+    fprintf(file, "  },\n");
+    fprintf(file, "  \"idle_share\": %.6f,\n", idleTicks / span);
+    fprintf(file, "  \"per_level\": [\n");
+    for (int i = 0; i < (int)busyTime.size(); i++) {
+        const LatencyHistogram& h = depth[i];
+        fprintf(file, "    {\"level\": %d, \"config\": \"%s\", \"cpu_time\": %lld, \"cpu_share\": %.6f, "
+                "\"depth\": {\"mean\": %.3f, \"p50\": %lld, \"p90\": %lld, \"p99\": %lld, \"max\": %lld}}%s\n",
+                i + 1, i < (int)levels.size() ? describeLevels(vector<QueueConfig>(1, levels[i])).c_str() : "",
+                busyTime[i], busyTime[i] / span, h.count() ? (double)depthArea[i] / h.count() : 0.0,
+                h.percentile(0.50), h.percentile(0.90), h.percentile(0.99), h.getMax(),
+                i + 1 < (int)busyTime.size() ? "," : "");
+    }
+    fprintf(file, "  ],\n");
+    fprintf(file, "  \"timers\": {\n");
+    for (int i = 0; i < TIMER_COUNT; i++) {
+        fprintf(file, "    \"%s\": {\"calls\": %lld, \"total_ms\": %.3f, \"ns_per_call\": %.1f}%s\n",
+                timerName(i), timerCalls[i], timerNanos[i] / 1e6,
+                timerCalls[i] ? (double)timerNanos[i] / timerCalls[i] : 0.0, i + 1 < TIMER_COUNT ? "," : "");
+    }
+    fprintf(file, "  }\n");
+    fprintf(file, "}\n");
+    bool ok = !ferror(file);
+    fclose(file);
+    return ok;
+}
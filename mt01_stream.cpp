@@ -0,0 +1,56 @@
+#include "mt01.h"
+
+// ---- Modo en linea ----
+
+// Cada linea se entrega al scheduler cuando se lee: antes se avanza el reloj
+// hasta su AT, asi que las llegadas deben venir ordenadas por AT (una con AT
+// ya pasado llega en el tiempo actual). Cada proceso se escribe en 'out'
+// apenas termina y despues se descarta, junto con su etiqueta. Leyendo de un
+// archivo ordenado por AT esto simula trazas que no entran en memoria: solo
+// se guardan los procesos vivos.
+bool runProcessStream(istream& in, FILE* out, MLFQ_Scheduler& scheduler) {
+    bool pendingOutput = false;
+    scheduler.setRetainFinished(false);
+    scheduler.setCompletionCallback([out, &pendingOutput](const Process& p) {
+        writeResultLine(out, p);
+        LabelTable::release(p.getLabelId());
+        if (p.hasIo()) BurstTable::release(p.getBurstsId());
+        pendingOutput = true;
+    });
+    writeResultsHeader(out);
+    fflush(out);
+
+    vector<Process> parsed;
+    string line, error;
+    long long lineNumber = 0, late = 0;
+    while (getline(in, line)) {
+        lineNumber++;
+        parsed.clear();
+        LineParse kind = parseProcessLine(line, parsed, error);
+        if (kind == LINE_INVALID) {
+            cerr << "Error en la linea " << lineNumber << ": " << error << " (linea ignorada)" << endl;
+            continue;
+        }
+        if (kind != LINE_PROCESS) continue;
+
+        const Process& p = parsed[0];
+        if (p.getArrivalTime() > scheduler.getCurrentTime()) scheduler.runUntil(p.getArrivalTime());
+        else if (p.getArrivalTime() < scheduler.getCurrentTime()) late++;
+        scheduler.submit(p);
+
+        // Entregar lo terminado antes de esperar la siguiente linea; si ya hay
+        // mas lineas leidas (un archivo) no hace falta vaciar en cada una
+        if (pendingOutput && in.rdbuf()->in_avail() <= 0) {
+            fflush(out);
+            pendingOutput = false;
+        }
+    }
+
+    scheduler.drain();
+    writeAveragesLine(out, scheduler.getMetrics());
+    fflush(out);
+    scheduler.setCompletionCallback(nullptr);
+
+    if (late > 0) cerr << late << " procesos llegaron con AT ya pasado y entraron en el tiempo actual" << endl;
+    return !in.bad();
+}
@@ -0,0 +1,153 @@
+#include "mt01.h"
+#include "mt01_static.h"
+#include <fstream>
+
+// ---- Grilla de configuraciones ----
+
+// Separa 'text' por 'sep' ignorando los separadores dentro de parentesis
+static vector<string> splitTopLevel(const string& text, char sep) {
+    vector<string> parts;
+    string current;
+    int depth = 0;
+    for (size_t i = 0; i < text.size(); i++) {
+        char c = text[i];
+        if (c == '(') depth++;
+        else if (c == ')') depth--;
+        if (c == sep && depth == 0) {
+            parts.push_back(current);
+            current.clear();
+        } else {
+            current += c;
+        }
+    }
+    parts.push_back(current);
+    return parts;
+}
+
+// Alternativas de un nivel: "SJF|STCF" o "RR(1|2|4)"
+static bool expandLevel(const string& token, vector<QueueConfig>& options) {
+    vector<string> alternatives = splitTopLevel(token, '|');
+    for (size_t a = 0; a < alternatives.size(); a++) {
+        const string& alt = alternatives[a];
+        size_t open = alt.find('(');
+        size_t close = alt.rfind(')');
+        vector<string> texts;
+        if (open != string::npos && close != string::npos && close > open) {
+            string prefix = alt.substr(0, open + 1);
+            string suffix = alt.substr(close);
+            stringstream inner(alt.substr(open + 1, close - open - 1));
+            string value;
+            while (getline(inner, value, '|')) texts.push_back(prefix + value + suffix);
+        } else {
+            texts.push_back(alt);
+        }
+        for (size_t t = 0; t < texts.size(); t++) {
+            vector<QueueConfig> level;
+            if (!parseLevels(texts[t], level) || level.size() != 1) return false;
+            options.push_back(level[0]);
+        }
+    }
+    return !options.empty();
+}
+
+// Expande una linea de la grilla al producto cartesiano de sus niveles,
+// por ejemplo "RR(1|2),RR(3),SJF|STCF" da 4 configuraciones
+bool expandGridLine(const string& line, vector<vector<QueueConfig> >& configs) {
+    vector<string> tokens = splitTopLevel(line, ',');
+    vector<vector<QueueConfig> > perLevel(tokens.size());
+    for (size_t i = 0; i < tokens.size(); i++) {
+        if (!expandLevel(tokens[i], perLevel[i])) return false;
+    }
+
+    vector<vector<QueueConfig> > product(1);
+    for (size_t i = 0; i < perLevel.size(); i++) {
+        vector<vector<QueueConfig> > next;
+        for (size_t p = 0; p < product.size(); p++) {
+            for (size_t o = 0; o < perLevel[i].size(); o++) {
+                next.push_back(product[p]);
+                next.back().push_back(perLevel[i][o]);
+            }
+        }
+        product.swap(next);
+    }
+    configs.insert(configs.end(), product.begin(), product.end());
+    return true;
+}
+
+bool loadSweepGrid(const string& filename, vector<vector<QueueConfig> >& configs) {
+    ifstream in(filename.c_str());
+    if (!in) {
+        cout << "Error: No se pudo abrir el archivo " << filename << endl;
+        return false;
+    }
+    string line;
+    int lineNumber = 0;
+    while (getline(in, line)) {
+        lineNumber++;
+        if (!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+        size_t first = line.find_first_not_of(" \t");
+        if (first == string::npos || line[first] == '#') continue;
+        if (!expandGridLine(line.substr(first), configs)) {
+            cout << "Error en " << filename << " linea " << lineNumber
+                 << ": configuracion invalida" << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// ---- Barrido ----
+
+// Cada configuracion se simula con su propio scheduler a partir de la traza
+// compartida (solo lectura). Los resultados se guardan por indice, asi que no
+// dependen del numero de hilos ni del orden en que terminan.
+vector<SweepResult> runSweep(const ProcessTrace& trace, const vector<vector<QueueConfig> >& configs,
+                             const FeedbackConfig& feedback, int threads) {
+    bool noFeedback = !feedback.demoteOnExpiry && feedback.boostPeriod <= 0;
+    vector<SweepResult> results(configs.size());
+    parallelFor((int)configs.size(), threads, [&](int i) {
+        results[i].levels = configs[i];
+
+        // Los esquemas predefinidos usan su instanciacion especializada, que
+        // no cambia procesos de cola: solo sin retroalimentacion
+        StaticRunResult fast;
+        if (noFeedback && runStaticScheme(matchBuiltInScheme(configs[i]), trace, fast)) {
+            results[i].summary = fast.metrics.getOverall();
+            results[i].makespan = fast.makespan;
+            return;
+        }
+
+        MLFQ_Scheduler scheduler(configs[i]);
+        scheduler.setEventDriven(true);
+        scheduler.setRetainFinished(false);
+        scheduler.setFeedback(feedback);
+        scheduler.setTimeline(make_shared<TimelineSink>(TIMELINE_OFF));
+        scheduler.loadTrace(trace);
+        scheduler.simulate();
+
+        results[i].summary = scheduler.getMetrics().getOverall();
+        results[i].makespan = scheduler.getCurrentTime();
+    });
+    return results;
+}
+
+bool writeSweepSummary(const string& filename, const vector<SweepResult>& results) {
+    FILE* file = fopen(filename.c_str(), "w");
+    if (file == NULL) {
+        cout << "Error: No se pudo crear el archivo " << filename << endl;
+        return false;
+    }
+    fprintf(file, "# config; procesos; WT; CT; RT; TAT; RT_p50; RT_p90; RT_p99; RT_max; WT_p99; TAT_p99; makespan\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        const MetricsSummary& m = results[i].summary;
+        fprintf(file, "%s;%lld;%.2f;%.2f;%.2f;%.2f;%lld;%lld;%lld;%lld;%lld;%lld;%lld\n",
+                describeLevels(results[i].levels).c_str(), m.count,
+                m.averageWT(), m.averageCT(), m.averageRT(), m.averageTAT(),
+                m.response.percentile(0.50), m.response.percentile(0.90),
+                m.response.percentile(0.99), m.response.getMax(),
+                m.waiting.percentile(0.99), m.turnaround.percentile(0.99),
+                (long long)results[i].makespan);
+    }
+    fclose(file);
+    return true;
+}
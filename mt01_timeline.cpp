@@ -0,0 +1,114 @@
+#include "mt01.h"
+#include <charconv>
+#include <cstring>
+
+// ---- TimelineSink ----
+
+// Tamano del buffer en espacio de usuario antes de cada fwrite
+static const size_t TIMELINE_BUFFER_BYTES = 1 << 20;
+
+TimelineSink::TimelineSink(TimelineLevel lvl, FILE* output)
+    : level(lvl), out(output), ownsFile(false), used(0),
+      pending(NULL), pendingStart(0), pendingEnd(0) {}
+
+TimelineSink::~TimelineSink() {
+    flush();
+    if (ownsFile) fclose(out);
+}
+
+// Redirige el timeline a un archivo (lo crea o lo trunca)
+bool TimelineSink::openFile(const string& filename) {
+    FILE* file = fopen(filename.c_str(), "w");
+    if (file == NULL) return false;
+    flush();
+    if (ownsFile) fclose(out);
+    out = file;
+    ownsFile = true;
+    return true;
+}
+
+void TimelineSink::setLevel(TimelineLevel lvl) { level = lvl; }
+TimelineLevel TimelineSink::getLevel() const { return level; }
+
+void TimelineSink::writeBuffer() {
+    if (used > 0) fwrite(&buffer[0], 1, used, out);
+    used = 0;
+}
+
+void TimelineSink::appendText(const char* text, size_t length) {
+    // El buffer se reserva con la primera escritura (un sink apagado no lo usa)
+    if (buffer.empty()) buffer.resize(TIMELINE_BUFFER_BYTES);
+    if (used + length > buffer.size()) {
+        writeBuffer();
+        if (length > buffer.size()) { fwrite(text, 1, length, out); return; }
+    }
+    memcpy(&buffer[used], text, length);
+    used += length;
+}
+
+void TimelineSink::appendText(const string& text) {
+    appendText(text.data(), text.size());
+}
+
+void TimelineSink::appendInt(long long value) {
+    char digits[24];
+    to_chars_result result = to_chars(digits, digits + sizeof(digits), value);
+    appendText(digits, result.ptr - digits);
+}
+
+// Escribe el intervalo acumulado como "t0-t1: X"
+void TimelineSink::flushPending() {
+    if (pending == NULL) return;
+    appendInt(pendingStart);
+    appendText("-", 1);
+    appendInt(pendingEnd);
+    appendText(": ", 2);
+    appendText(pending->getLabel());
+    appendText("\n", 1);
+    pending = NULL;
+}
+
+void TimelineSink::summary(const string& text) {
+    if (level < TIMELINE_SUMMARY) return;
+    flushPending();
+    appendText(text);
+    appendText("\n", 1);
+}
+
+void TimelineSink::run(const Process& p, SimTime start, SimTime timeSlice) {
+    if (level == TIMELINE_TICKS) {
+        appendText("Tiempo ", 7);
+        appendInt(start);
+        appendText(": Ejecutando proceso ", 21);
+        appendText(p.getLabel());
+        appendText(" por ", 5);
+        appendInt(timeSlice);
+        appendText(" unidades\n", 10);
+    } else if (level == TIMELINE_DECISIONS) {
+        // Tramos seguidos del mismo proceso se juntan en un solo intervalo
+        if (pending == &p && pendingEnd == start) {
+            pendingEnd = start + timeSlice;
+            return;
+        }
+        flushPending();
+        pending = &p;
+        pendingStart = start;
+        pendingEnd = start + timeSlice;
+    }
+}
+
+void TimelineSink::flush() {
+    flushPending();
+    writeBuffer();
+    fflush(out);
+}
+
+// Convierte "off", "summary", "decisions" o "ticks" en un nivel
+bool parseTimelineLevel(const string& name, TimelineLevel& lvl) {
+    if (name == "off") lvl = TIMELINE_OFF;
+    else if (name == "summary") lvl = TIMELINE_SUMMARY;
+    else if (name == "decisions") lvl = TIMELINE_DECISIONS;
+    else if (name == "ticks") lvl = TIMELINE_TICKS;
+    else return false;
+    return true;
+}
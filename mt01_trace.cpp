@@ -0,0 +1,599 @@
+#include "mt01.h"
+#include <algorithm>
+#include <cstring>
+#include <climits>
+
+// ---- Formato ----
+
+// Cabecera: firma, version y orden de bytes (como los checkpoints, el archivo
+// es para la misma plataforma). Despues van los bloques, el indice y un pie
+// con la posicion del indice. Cada intervalo de un bloque son 4 varints:
+// hueco desde el fin del anterior, largo, pid menos el anterior (zigzag) y
+// nivel * 8 + motivo. El indice tambien va en varints: los bloques son
+// contiguos, asi que de cada uno basta su rango de tiempo, intervalos y bytes.
+static const char TRACE_MAGIC[8] = { 'M', 'L', 'F', 'Q', 'T', 'R', 'A', 'Z' };
+static const char TRACE_END_MAGIC[8] = { 'M', 'L', 'F', 'Q', 'T', 'E', 'N', 'D' };
+static const int TRACE_VERSION = 1;
+static const int TRACE_BYTE_ORDER = 0x01020304;
+static const int TRACE_HEADER_BYTES = 16;
+static const int TRACE_FOOTER_BYTES = 16;
+static const int TRACE_BLOCK_INTERVALS = 4096;
+static const int TRACE_REASONS = 8;
+
+const char* describeIntervalReason(IntervalReason reason) {
+    switch (reason) {
+        case END_FINISH: return "termino";
+        case END_QUANTUM: return "quantum";
+        case END_DEMOTE: return "democion";
+        case END_ARRIVAL: return "llegada";
+        case END_PREEMPT: return "expropiado";
+        case END_BOOST: return "boost";
+        case END_IO: return "e/s";
+        default: return "corte";
+    }
+}
+
+static void putVarint(vector<unsigned char>& out, unsigned long long value) {
+    while (value >= 0x80) {
+        out.push_back((unsigned char)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((unsigned char)value);
+}
+
+static bool getVarint(const unsigned char*& p, const unsigned char* end, unsigned long long& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        unsigned char byte = *p++;
+        value |= (unsigned long long)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+static unsigned long long zigzag(long long value) {
+    return ((unsigned long long)value << 1) ^ (unsigned long long)(value >> 63);
+}
+
+static long long unzigzag(unsigned long long value) {
+    return (long long)(value >> 1) ^ -(long long)(value & 1);
+}
+
+// fseek con posiciones de 64 bits (long es de 32 bits en Windows)
+static bool seekTo(FILE* file, long long offset, int origin) {
+#ifdef _WIN32
+    return _fseeki64(file, offset, origin) == 0;
+#else
+    return fseeko(file, (off_t)offset, origin) == 0;
+#endif
+}
+
+static long long tellPosition(FILE* file) {
+#ifdef _WIN32
+    return _ftelli64(file);
+#else
+    return (long long)ftello(file);
+#endif
+}
+
+// ---- IntervalTraceWriter ----
+
+IntervalTraceWriter::IntervalTraceWriter()
+    : out(NULL), failed(false), previousEnd(0), previousPid(0), intervals(0), open(false),
+      openHandle(-1), openLevel(0), openStart(0), openEnd(0) {
+    current.offset = TRACE_HEADER_BYTES;
+    current.start = current.end = 0;
+    current.count = current.bytes = 0;
+}
+
+IntervalTraceWriter::~IntervalTraceWriter() {
+    close();
+}
+
+void IntervalTraceWriter::raw(const void* data, size_t size) {
+    if (!failed && size > 0 && fwrite(data, 1, size, out) != size) failed = true;
+}
+
+bool IntervalTraceWriter::create(const string& filename, const vector<QueueConfig>& levels) {
+    out = fopen(filename.c_str(), "wb");
+    if (out == NULL) return false;
+    levelNames.clear();
+    for (size_t i = 0; i < levels.size(); i++)
+        levelNames.push_back(describeLevels(vector<QueueConfig>(1, levels[i])));
+    raw(TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    raw(&TRACE_VERSION, sizeof(int));
+    raw(&TRACE_BYTE_ORDER, sizeof(int));
+    block.reserve(TRACE_BLOCK_INTERVALS * 8);
+    return !failed;
+}
+
+// Los tramos seguidos del mismo proceso en el mismo nivel extienden el
+// intervalo abierto; cualquier otro lo cierra (sin motivo si nadie llamo a stop)
+void IntervalTraceWriter::run(const Process& p, int handle, int level, long long start, SimTime timeSlice) {
+    if (out == NULL) return;
+    if (open && handle == openHandle && level == openLevel && start == openEnd) {
+        openEnd += timeSlice;
+        return;
+    }
+    if (open) emit(END_CUT);
+    if (handle >= (int)pidOfHandle.size()) pidOfHandle.resize(handle + 1, -1);
+    if (pidOfHandle[handle] < 0) {
+        pidOfHandle[handle] = (int)labels.size();
+        labels.push_back(p.getLabel());
+        firstBlock.push_back(-1);
+        lastBlock.push_back(-1);
+        cpuTime.push_back(0);
+    }
+    open = true;
+    openHandle = handle;
+    openLevel = level;
+    openStart = start;
+    openEnd = start + timeSlice;
+}
+
+void IntervalTraceWriter::stop(IntervalReason reason) {
+    if (!open) return;
+    emit(reason);
+    // Un proceso terminado libera su handle: el proximo que lo use es otro pid
+    if (reason == END_FINISH) pidOfHandle[openHandle] = -1;
+    open = false;
+}
+
+void IntervalTraceWriter::emit(IntervalReason reason) {
+    int pid = pidOfHandle[openHandle];
+    if (current.count == 0) {
+        current.start = openStart;
+        previousEnd = openStart;
+        previousPid = 0;
+    }
+    putVarint(block, (unsigned long long)(openStart - previousEnd));
+    putVarint(block, (unsigned long long)(openEnd - openStart));
+    putVarint(block, zigzag((long long)pid - previousPid));
+    putVarint(block, (unsigned long long)openLevel * TRACE_REASONS + reason);
+    previousEnd = openEnd;
+    previousPid = pid;
+    current.count++;
+    intervals++;
+
+    int b = (int)index.size();
+    if (firstBlock[pid] < 0) firstBlock[pid] = b;
+    lastBlock[pid] = b;
+    cpuTime[pid] += openEnd - openStart;
+    if (current.count == TRACE_BLOCK_INTERVALS) flushBlock();
+}
+
+void IntervalTraceWriter::flushBlock() {
+    if (current.count == 0) return;
+    current.end = previousEnd;
+    current.bytes = (int)block.size();
+    raw(&block[0], block.size());
+    index.push_back(current);
+    current.offset += current.bytes;
+    current.count = 0;
+    block.clear();
+}
+
+static void putText(vector<unsigned char>& out, const string& text) {
+    putVarint(out, text.size());
+    out.insert(out.end(), text.begin(), text.end());
+}
+
+// Indice: niveles, bloques y procesos; el pie dice donde empieza
+bool IntervalTraceWriter::close() {
+    if (out == NULL) return !failed;
+    if (open) {
+        emit(END_CUT);
+        open = false;
+    }
+    flushBlock();
+    long long trailer = current.offset;
+    vector<unsigned char>& data = block;
+    putVarint(data, levelNames.size());
+    for (size_t i = 0; i < levelNames.size(); i++) putText(data, levelNames[i]);
+    putVarint(data, index.size());
+    long long previous = 0;
+    for (size_t b = 0; b < index.size(); b++) {
+        putVarint(data, (unsigned long long)(index[b].start - previous));
+        putVarint(data, (unsigned long long)(index[b].end - index[b].start));
+        putVarint(data, index[b].count);
+        putVarint(data, index[b].bytes);
+        previous = index[b].end;
+    }
+    putVarint(data, labels.size());
+    for (size_t pid = 0; pid < labels.size(); pid++) {
+        putVarint(data, firstBlock[pid] + 1);
+        putVarint(data, lastBlock[pid] - firstBlock[pid]);
+        putVarint(data, cpuTime[pid]);
+        putText(data, labels[pid]);
+    }
+    if (!data.empty()) raw(&data[0], data.size());
+    block.clear();
+    raw(&trailer, sizeof(trailer));
+    raw(TRACE_END_MAGIC, sizeof(TRACE_END_MAGIC));
+    if (fclose(out) != 0) failed = true;
+    out = NULL;
+    return !failed;
+}
+
+long long IntervalTraceWriter::getIntervals() const { return intervals; }
+
+// ---- IntervalTraceReader ----
+
+IntervalTraceReader::IntervalTraceReader() : file(NULL), fileBytes(0) {}
+
+IntervalTraceReader::~IntervalTraceReader() {
+    if (file != NULL) fclose(file);
+}
+
+// Lee 'size' bytes; false si el archivo se corta
+static bool readRaw(FILE* file, void* data, size_t size) {
+    return size == 0 || fread(data, 1, size, file) == size;
+}
+
+// Varints del indice con un tope (un valor mayor indica un archivo corrupto)
+static bool getBounded(const unsigned char*& p, const unsigned char* end, long long limit, long long& value) {
+    unsigned long long raw;
+    if (!getVarint(p, end, raw) || raw > (unsigned long long)limit) return false;
+    value = (long long)raw;
+    return true;
+}
+
+static bool getText(const unsigned char*& p, const unsigned char* end, string& text) {
+    long long length;
+    if (!getBounded(p, end, end - p, length)) return false;
+    text.assign((const char*)p, (size_t)length);
+    p += length;
+    return true;
+}
+
+bool IntervalTraceReader::open(const string& filename, string& error) {
+    file = fopen(filename.c_str(), "rb");
+    if (file == NULL) {
+        error = "no se pudo abrir";
+        return false;
+    }
+    char magic[8];
+    int version = 0, byteOrder = 0;
+    if (!readRaw(file, magic, sizeof(magic)) || memcmp(magic, TRACE_MAGIC, sizeof(magic)) != 0 ||
+        !readRaw(file, &version, sizeof(int)) || !readRaw(file, &byteOrder, sizeof(int))) {
+        error = "no es una traza de intervalos";
+        return false;
+    }
+    if (byteOrder != TRACE_BYTE_ORDER || version != TRACE_VERSION) {
+        error = "traza de otra version o de otra arquitectura";
+        return false;
+    }
+
+    // Pie: donde empieza el indice
+    long long trailer = 0;
+    if (!seekTo(file, 0, SEEK_END)) {
+        error = "no se pudo leer";
+        return false;
+    }
+    fileBytes = tellPosition(file);
+    if (fileBytes < TRACE_HEADER_BYTES + TRACE_FOOTER_BYTES || !seekTo(file, fileBytes - TRACE_FOOTER_BYTES, SEEK_SET) ||
+        !readRaw(file, &trailer, sizeof(trailer)) || !readRaw(file, magic, sizeof(magic)) ||
+        memcmp(magic, TRACE_END_MAGIC, sizeof(magic)) != 0 || trailer < TRACE_HEADER_BYTES ||
+        trailer > fileBytes - TRACE_FOOTER_BYTES || !seekTo(file, trailer, SEEK_SET)) {
+        error = "traza incompleta (la simulacion no termino de escribirla)";
+        return false;
+    }
+
+    // Cada elemento del indice ocupa al menos un byte: los conteos no pueden
+    // pasar del largo del indice
+    vector<unsigned char> data((size_t)(fileBytes - TRACE_FOOTER_BYTES - trailer));
+    bool ok = readRaw(file, data.empty() ? NULL : &data[0], data.size());
+    const unsigned char* p = data.empty() ? NULL : &data[0];
+    const unsigned char* end = p + data.size();
+    long long limit = (long long)data.size();
+    long long count = 0, value = 0;
+    ok = ok && getBounded(p, end, limit, count);
+    levelNames.resize(ok ? (size_t)count : 0);
+    for (size_t i = 0; ok && i < levelNames.size(); i++) ok = getText(p, end, levelNames[i]);
+
+    ok = ok && getBounded(p, end, limit, count);
+    index.resize(ok ? (size_t)count : 0);
+    long long offset = TRACE_HEADER_BYTES, time = 0;
+    for (size_t b = 0; ok && b < index.size(); b++) {
+        TraceBlockInfo& info = index[b];
+        info.offset = offset;
+        ok = getBounded(p, end, LLONG_MAX - time, value);
+        info.start = time + value;
+        ok = ok && getBounded(p, end, LLONG_MAX - info.start, value);
+        info.end = info.start + value;
+        ok = ok && getBounded(p, end, TRACE_BLOCK_INTERVALS, value) && value > 0;
+        info.count = (int)value;
+        ok = ok && getBounded(p, end, trailer - offset, value);
+        info.bytes = (int)value;
+        offset += info.bytes;
+        time = info.end;
+    }
+    ok = ok && offset == trailer;
+
+    ok = ok && getBounded(p, end, limit, count);
+    size_t processes = ok ? (size_t)count : 0;
+    labels.resize(processes);
+    firstBlock.resize(processes);
+    lastBlock.resize(processes);
+    cpuTime.resize(processes);
+    for (size_t pid = 0; ok && pid < processes; pid++) {
+        ok = getBounded(p, end, (long long)index.size(), value);
+        firstBlock[pid] = (int)value - 1;
+        ok = ok && getBounded(p, end, (long long)index.size() - 1 - firstBlock[pid], value);
+        lastBlock[pid] = firstBlock[pid] + (int)value;
+        ok = ok && getBounded(p, end, LLONG_MAX, cpuTime[pid]) && getText(p, end, labels[pid]);
+    }
+    if (!ok || p != end) {
+        error = "indice de la traza corrupto";
+        return false;
+    }
+    return true;
+}
+
+// Decodifica el bloque b; false si los datos no coinciden con el indice
+bool IntervalTraceReader::readBlock(int b, vector<TraceInterval>& intervals) const {
+    intervals.clear();
+    const TraceBlockInfo& info = index[b];
+    vector<unsigned char> data(info.bytes);
+    if (!seekTo(file, info.offset, SEEK_SET) || !readRaw(file, data.empty() ? NULL : &data[0], data.size()))
+        return false;
+    const unsigned char* p = data.empty() ? NULL : &data[0];
+    const unsigned char* end = p + data.size();
+    long long previousEnd = info.start;
+    long long previousPid = 0;
+    intervals.reserve(info.count);
+    for (int i = 0; i < info.count; i++) {
+        unsigned long long gap, length, pidDelta, code;
+        if (!getVarint(p, end, gap) || !getVarint(p, end, length) || !getVarint(p, end, pidDelta) ||
+            !getVarint(p, end, code))
+            return false;
+        TraceInterval interval;
+        interval.start = previousEnd + (long long)gap;
+        interval.end = interval.start + (long long)length;
+        interval.pid = (int)(previousPid + unzigzag(pidDelta));
+        interval.level = (int)(code / TRACE_REASONS);
+        interval.reason = (IntervalReason)(code % TRACE_REASONS);
+        if (interval.pid < 0 || interval.pid >= (int)labels.size()) return false;
+        intervals.push_back(interval);
+        previousEnd = interval.end;
+        previousPid = interval.pid;
+    }
+    return p == end && previousEnd == info.end;
+}
+
+// Los bloques estan ordenados por tiempo y no se solapan: busqueda binaria
+int IntervalTraceReader::findBlock(long long time) const {
+    int low = 0, high = (int)index.size();
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (index[mid].start <= time) low = mid + 1;
+        else high = mid;
+    }
+    return low - 1;
+}
+
+int IntervalTraceReader::firstBlockEndingAfter(long long time) const {
+    int low = 0, high = (int)index.size();
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (index[mid].end <= time) low = mid + 1;
+        else high = mid;
+    }
+    return low;
+}
+
+int IntervalTraceReader::getLevels() const { return (int)levelNames.size(); }
+const string& IntervalTraceReader::getLevelName(int level) const { return levelNames[level]; }
+int IntervalTraceReader::getBlocks() const { return (int)index.size(); }
+long long IntervalTraceReader::getFileBytes() const { return fileBytes; }
+
+long long IntervalTraceReader::getIntervals() const {
+    long long total = 0;
+    for (size_t b = 0; b < index.size(); b++) total += index[b].count;
+    return total;
+}
+
+long long IntervalTraceReader::getStart() const { return index.empty() ? 0 : index[0].start; }
+long long IntervalTraceReader::getEnd() const { return index.empty() ? 0 : index.back().end; }
+int IntervalTraceReader::getProcesses() const { return (int)labels.size(); }
+const string& IntervalTraceReader::getLabel(int pid) const { return labels[pid]; }
+int IntervalTraceReader::getFirstBlock(int pid) const { return firstBlock[pid]; }
+int IntervalTraceReader::getLastBlock(int pid) const { return lastBlock[pid]; }
+long long IntervalTraceReader::getCpuTime(int pid) const { return cpuTime[pid]; }
+const TraceBlockInfo& IntervalTraceReader::getBlock(int b) const { return index[b]; }
+
+// ---- Consultas ----
+
+// "T0,T1" -> ventana [T0, T1)
+bool parseTraceWindow(const string& text, long long& from, long long& to) {
+    size_t comma = text.find(',');
+    if (comma == string::npos) return false;
+    char* end;
+    from = strtoll(text.c_str(), &end, 10);
+    if (end != text.c_str() + comma) return false;
+    to = strtoll(text.c_str() + comma + 1, &end, 10);
+    return *end == '\0' && from >= 0 && from < to;
+}
+
+static void printInterval(const IntervalTraceReader& reader, const TraceInterval& interval) {
+    printf("[%lld, %lld)\t%s\tpid %d\tnivel %d\t%s\n", interval.start, interval.end,
+           reader.getLabel(interval.pid).c_str(), interval.pid, interval.level + 1,
+           describeIntervalReason(interval.reason));
+}
+
+// Que corria en 'at': un solo bloque
+static bool queryAt(const IntervalTraceReader& reader, long long at) {
+    int b = reader.findBlock(at);
+    vector<TraceInterval> intervals;
+    if (b >= 0 && at < reader.getBlock(b).end) {
+        if (!reader.readBlock(b, intervals)) return false;
+        for (size_t i = 0; i < intervals.size(); i++) {
+            if (intervals[i].start <= at && at < intervals[i].end) {
+                printf("t=%lld: ", at);
+                printInterval(reader, intervals[i]);
+                return true;
+            }
+        }
+    }
+    printf("t=%lld: CPU ociosa\n", at);
+    return true;
+}
+
+// Intervalos de los procesos con esa etiqueta: solo los bloques entre el
+// primero y el ultimo de cada uno
+static bool queryLabel(const IntervalTraceReader& reader, const string& label) {
+    vector<char> wanted(reader.getProcesses(), 0);
+    vector<pair<int, int> > ranges;
+    for (int pid = 0; pid < reader.getProcesses(); pid++) {
+        if (reader.getLabel(pid) != label || reader.getFirstBlock(pid) < 0) continue;
+        wanted[pid] = 1;
+        ranges.push_back(make_pair(reader.getFirstBlock(pid), reader.getLastBlock(pid)));
+    }
+    if (ranges.empty()) {
+        printf("%s no aparece en la traza\n", label.c_str());
+        return true;
+    }
+    sort(ranges.begin(), ranges.end());
+
+    vector<TraceInterval> intervals;
+    long long cpu = 0;
+    int blocksRead = 0, next = 0;
+    for (size_t r = 0; r < ranges.size(); r++) {
+        for (int b = max(next, ranges[r].first); b <= ranges[r].second; b++) {
+            if (!reader.readBlock(b, intervals)) return false;
+            blocksRead++;
+            for (size_t i = 0; i < intervals.size(); i++) {
+                if (!wanted[intervals[i].pid]) continue;
+                printInterval(reader, intervals[i]);
+                cpu += intervals[i].end - intervals[i].start;
+            }
+        }
+        next = max(next, ranges[r].second + 1);
+    }
+    printf("%s: %d proceso(s), %lld unidades de CPU (%d de %d bloques leidos)\n", label.c_str(),
+           (int)ranges.size(), cpu, blocksRead, reader.getBlocks());
+    return true;
+}
+
+// Recorre los intervalos que se cruzan con [from, to), recortados a la ventana
+static bool forEachInWindow(const IntervalTraceReader& reader, long long from, long long to,
+                            const function<void(const TraceInterval&)>& visit) {
+    vector<TraceInterval> intervals;
+    for (int b = reader.firstBlockEndingAfter(from); b < reader.getBlocks() && reader.getBlock(b).start < to; b++) {
+        if (!reader.readBlock(b, intervals)) return false;
+        for (size_t i = 0; i < intervals.size(); i++) {
+            TraceInterval clipped = intervals[i];
+            if (clipped.end <= from || clipped.start >= to) continue;
+            clipped.start = max(clipped.start, from);
+            clipped.end = min(clipped.end, to);
+            visit(clipped);
+        }
+    }
+    return true;
+}
+
+// Actividad de cada nivel en la ventana: CPU, intervalos y como terminaron
+static bool queryWindow(const IntervalTraceReader& reader, long long from, long long to) {
+    int levels = reader.getLevels();
+    vector<long long> busy(levels, 0), count(levels, 0);
+    vector<vector<long long> > reasons(levels, vector<long long>(TRACE_REASONS, 0));
+    vector<char> seen(reader.getProcesses(), 0);
+    int processes = 0;
+    bool ok = forEachInWindow(reader, from, to, [&](const TraceInterval& interval) {
+        if (interval.level >= levels) return;
+        busy[interval.level] += interval.end - interval.start;
+        count[interval.level]++;
+        reasons[interval.level][interval.reason]++;
+        if (!seen[interval.pid]) {
+            seen[interval.pid] = 1;
+            processes++;
+        }
+    });
+    if (!ok) return false;
+
+    long long total = 0;
+    printf("Ventana [%lld, %lld): %d procesos\n", from, to, processes);
+    printf("%-6s %-12s %12s %8s %10s  %s\n", "nivel", "politica", "cpu", "cpu%", "intervalos", "motivos");
+    for (int i = 0; i < levels; i++) {
+        string detail;
+        for (int r = 0; r < TRACE_REASONS; r++) {
+            if (reasons[i][r] == 0) continue;
+            if (!detail.empty()) detail += ", ";
+            detail += string(describeIntervalReason((IntervalReason)r)) + "=" + to_string(reasons[i][r]);
+        }
+        printf("%-6d %-12s %12lld %7.2f%% %10lld  %s\n", i + 1, reader.getLevelName(i).c_str(), busy[i],
+               100.0 * busy[i] / (to - from), count[i], detail.c_str());
+        total += busy[i];
+    }
+    printf("%-6s %-12s %12lld %7.2f%%\n", "ocio", "", (to - from) - total, 100.0 * ((to - from) - total) / (to - from));
+    return true;
+}
+
+static void writeJsonString(FILE* file, const string& text) {
+    fputc('"', file);
+    for (size_t i = 0; i < text.size(); i++) {
+        unsigned char c = (unsigned char)text[i];
+        if (c == '"' || c == '\\') fprintf(file, "\\%c", c);
+        else if (c < 0x20) fprintf(file, "\\u%04x", c);
+        else fputc(c, file);
+    }
+    fputc('"', file);
+}
+
+// Trace Event Format de Chrome (chrome://tracing, Perfetto): un evento
+// completo ("X") por intervalo, una fila por nivel y 1 unidad = 1 us
+static bool exportChrome(const IntervalTraceReader& reader, long long from, long long to, const string& filename) {
+    FILE* file = fopen(filename.c_str(), "w");
+    if (file == NULL) {
+        cout << "Error: No se pudo crear el archivo " << filename << endl;
+        return false;
+    }
+    fprintf(file, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n");
+    fprintf(file, "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"args\": {\"name\": \"MLFQ\"}}");
+    for (int i = 0; i < reader.getLevels(); i++) {
+        fprintf(file, ",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %d, \"args\": {\"name\": ", i + 1);
+        writeJsonString(file, "Nivel " + to_string(i + 1) + " " + reader.getLevelName(i));
+        fprintf(file, "}}");
+    }
+    long long events = 0;
+    bool ok = forEachInWindow(reader, from, to, [&](const TraceInterval& interval) {
+        fprintf(file, ",\n{\"name\": ");
+        writeJsonString(file, reader.getLabel(interval.pid));
+        fprintf(file, ", \"ph\": \"X\", \"pid\": 1, \"tid\": %d, \"ts\": %lld, \"dur\": %lld, "
+                "\"args\": {\"pid\": %d, \"motivo\": \"%s\"}}",
+                interval.level + 1, interval.start, interval.end - interval.start, interval.pid,
+                describeIntervalReason(interval.reason));
+        events++;
+    });
+    fprintf(file, "\n]}\n");
+    ok = ok && !ferror(file);
+    fclose(file);
+    if (ok) printf("Exportados %lld intervalos de [%lld, %lld) a %s\n", events, from, to, filename.c_str());
+    return ok;
+}
+
+bool runTraceQuery(const string& filename, const TraceQuery& query) {
+    IntervalTraceReader reader;
+    string error;
+    if (!reader.open(filename, error)) {
+        cout << "Error: " << filename << ": " << error << endl;
+        return false;
+    }
+    long long intervals = reader.getIntervals();
+    printf("Traza %s: %lld intervalos en %d bloques, %d procesos, %d niveles, tiempo [%lld, %lld), "
+           "%lld bytes (%.2f por intervalo)\n", filename.c_str(), intervals, reader.getBlocks(),
+           reader.getProcesses(), reader.getLevels(), reader.getStart(), reader.getEnd(),
+           reader.getFileBytes(), intervals > 0 ? (double)reader.getFileBytes() / intervals : 0.0);
+
+    bool ok = true;
+    if (query.at >= 0) ok = ok && queryAt(reader, query.at);
+    if (!query.label.empty()) ok = ok && queryLabel(reader, query.label);
+    if (query.from >= 0 || !query.chromeFile.empty()) {
+        long long from = query.from >= 0 ? query.from : reader.getStart();
+        long long to = query.from >= 0 ? query.to : max(reader.getEnd(), from + 1);
+        if (query.chromeFile.empty()) ok = ok && queryWindow(reader, from, to);
+        else ok = ok && exportChrome(reader, from, to, query.chromeFile);
+    }
+    if (!ok) cout << "Error: no se pudo completar la consulta sobre " << filename << endl;
+    return ok;
+}
@@ -0,0 +1,204 @@
+#include "mt01.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+// ---- Objetivo ----
+
+TuneObjective::TuneObjective() : meanRT(1), p99RT(0), meanTAT(0) {}
+
+// Cada termino es "rt", "p99" o "tat", con peso 1 o con "=PESO"
+bool parseTuneObjective(const string& text, TuneObjective& objective) {
+    TuneObjective parsed;
+    parsed.meanRT = 0;
+    stringstream ss(text);
+    string token;
+    while (getline(ss, token, ',')) {
+        token = trimSpaces(token);
+        double weight = 1;
+        size_t eq = token.find('=');
+        if (eq != string::npos) {
+            char* end = NULL;
+            string value = token.substr(eq + 1);
+            weight = strtod(value.c_str(), &end);
+            if (value.empty() || *end != '\0' || weight < 0) return false;
+            token = token.substr(0, eq);
+        }
+        if (token == "rt") parsed.meanRT = weight;
+        else if (token == "p99") parsed.p99RT = weight;
+        else if (token == "tat") parsed.meanTAT = weight;
+        else return false;
+    }
+    if (parsed.meanRT + parsed.p99RT + parsed.meanTAT <= 0) return false;
+    objective = parsed;
+    return true;
+}
+
+string describeTuneObjective(const TuneObjective& objective) {
+    const double weights[] = { objective.meanRT, objective.p99RT, objective.meanTAT };
+    const char* names[] = { "rt", "p99", "tat" };
+    string text;
+    for (int i = 0; i < 3; i++) {
+        if (weights[i] <= 0) continue;
+        if (!text.empty()) text += ",";
+        text += names[i];
+        if (weights[i] != 1) {
+            char buffer[32];
+            snprintf(buffer, sizeof(buffer), "=%g", weights[i]);
+            text += buffer;
+        }
+    }
+    return text;
+}
+
+// Menor es mejor
+double tuneScore(const TuneObjective& objective, const MetricsSummary& summary) {
+    if (summary.count == 0) return 0;
+    double score = 0;
+    if (objective.meanRT > 0) score += objective.meanRT * summary.averageRT();
+    if (objective.p99RT > 0) score += objective.p99RT * (double)summary.response.percentile(0.99);
+    if (objective.meanTAT > 0) score += objective.meanTAT * summary.averageTAT();
+    return score;
+}
+
+// ---- Reduccion sucesiva a la mitad ----
+
+// Cuatro niveles como los esquemas 1-3: quantums crecientes en los tres
+// primeros y la politica del ultimo
+const char* const DEFAULT_TUNE_GRID =
+    "RR(1|2|3|4|6|8),RR(2|3|4|6|8|12),RR(3|4|6|8|12|16|20),SJF|STCF|RR(20)";
+
+// Prefijo minimo de la primera ronda: con menos procesos el orden de los
+// candidatos depende mas del arranque que de los quantums
+static const int MIN_TUNE_PREFIX = 1024;
+
+TuneResult::TuneResult() : score(0), simulatedProcesses(0) {}
+
+static MetricsSummary simulateTunePrefix(const ProcessTrace& trace, const vector<QueueConfig>& levels,
+                                         const FeedbackConfig& feedback, int count) {
+    MLFQ_Scheduler scheduler(levels);
+    scheduler.setEventDriven(true);
+    scheduler.setRetainFinished(false);
+    scheduler.setFeedback(feedback);
+    scheduler.setTimeline(make_shared<TimelineSink>(TIMELINE_OFF));
+    scheduler.loadTracePrefix(trace, count);
+    scheduler.simulate();
+    return scheduler.getMetrics().getOverall();
+}
+
+// Con N candidatos hay ceil(log2 N) rondas; el prefijo se duplica en cada una
+// y la ultima (la de los dos finalistas) usa toda la traza, asi que el costo
+// total es del orden de 2 * rondas simulaciones completas en vez de N
+bool runTuner(const ProcessTrace& trace, const vector<vector<QueueConfig> >& candidates,
+              const TuneObjective& objective, const FeedbackConfig& feedback, int threads,
+              TuneResult& result) {
+    if (candidates.empty()) return false;
+    int total = (int)trace.size();
+    int rounds = 1;
+    while ((1LL << rounds) < (long long)candidates.size()) rounds++;
+
+    vector<int> alive(candidates.size());
+    for (int i = 0; i < (int)alive.size(); i++) alive[i] = i;
+    result = TuneResult();
+
+    for (int round = 0; round < rounds; round++) {
+        int shift = rounds - 1 - round;
+        int prefix = shift >= 31 ? 0 : total >> shift;
+        prefix = min(total, max(prefix, MIN_TUNE_PREFIX));
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        vector<double> scores(alive.size());
+        vector<MetricsSummary> summaries(alive.size());
+        parallelFor((int)alive.size(), threads, [&](int i) {
+            summaries[i] = simulateTunePrefix(trace, candidates[alive[i]], feedback, prefix);
+            scores[i] = tuneScore(objective, summaries[i]);
+        });
+
+        // Empates por orden en la grilla: el resultado no depende de los hilos
+        vector<int> ranked(alive.size());
+        for (int i = 0; i < (int)ranked.size(); i++) ranked[i] = i;
+        sort(ranked.begin(), ranked.end(), [&](int a, int b) {
+            if (scores[a] != scores[b]) return scores[a] < scores[b];
+            return alive[a] < alive[b];
+        });
+
+        TuneRound info;
+        info.candidates = (int)alive.size();
+        info.prefix = prefix;
+        info.bestScore = scores[ranked[0]];
+        info.millis = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        result.rounds.push_back(info);
+        result.simulatedProcesses += (long long)prefix * (long long)alive.size();
+
+        if (round == rounds - 1) {
+            result.best = candidates[alive[ranked[0]]];
+            result.summary = summaries[ranked[0]];
+            result.score = scores[ranked[0]];
+            break;
+        }
+        vector<int> survivors;
+        for (int i = 0; i < ((int)ranked.size() + 1) / 2; i++) survivors.push_back(alive[ranked[i]]);
+        alive.swap(survivors);
+    }
+    return true;
+}
+
+// ---- Archivo de niveles ----
+
+bool writeTunedLevels(const string& filename, const TuneResult& result, const TuneObjective& objective,
+                      const FeedbackConfig& feedback) {
+    FILE* file = fopen(filename.c_str(), "w");
+    if (file == NULL) {
+        cout << "Error: No se pudo crear el archivo " << filename << endl;
+        return false;
+    }
+    const MetricsSummary& m = result.summary;
+    int candidates = result.rounds.empty() ? 0 : result.rounds[0].candidates;
+    fprintf(file, "# --tune: objetivo %s; %d candidatos en %d rondas\n",
+            describeTuneObjective(objective).c_str(), candidates, (int)result.rounds.size());
+    fprintf(file, "# puntaje %.2f sobre %lld procesos: RT=%.2f; RT_p99=%lld; TAT=%.2f\n",
+            result.score, m.count, m.averageRT(), m.response.percentile(0.99), m.averageTAT());
+    fprintf(file, "%s\n", describeLevels(result.best).c_str());
+    fprintf(file, "feedback=%s\n", describeFeedback(feedback).c_str());
+    if (fclose(file) != 0) {
+        cout << "Error: No se pudo escribir el archivo " << filename << endl;
+        return false;
+    }
+    return true;
+}
+
+// La primera linea que no es comentario ni vacia tiene los niveles; puede
+// seguirle "feedback=REGLAS" con la retroalimentacion del ajuste
+bool loadLevelsFile(const string& filename, vector<QueueConfig>& levels, FeedbackConfig& feedback,
+                    bool& hasFeedback) {
+    ifstream in(filename.c_str());
+    if (!in) {
+        cout << "Error: No se pudo abrir el archivo " << filename << endl;
+        return false;
+    }
+    vector<QueueConfig> parsed;
+    hasFeedback = false;
+    string line;
+    while (getline(in, line)) {
+        if (!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+        line = trimSpaces(line);
+        if (line.empty() || line[0] == '#') continue;
+        if (parsed.empty()) {
+            if (parseLevels(line, parsed)) continue;
+            cout << "Error: niveles invalidos en " << filename << ": " << line << endl;
+            return false;
+        }
+        if (!hasFeedback && line.compare(0, 9, "feedback=") == 0 && parseFeedback(line.substr(9), feedback)) {
+            hasFeedback = true;
+            continue;
+        }
+        cout << "Error: linea invalida en " << filename << ": " << line << endl;
+        return false;
+    }
+    if (parsed.empty()) {
+        cout << "Error: " << filename << " no tiene niveles" << endl;
+        return false;
+    }
+    levels = parsed;
+    return true;
+}
@@ -0,0 +1,166 @@
+#include "mt01.h"
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+
+// ---- Generador de cargas sinteticas ----
+
+WorkloadConfig::WorkloadConfig()
+    : count(1000), seed(1), arrivals(ARRIVALS_POISSON), rate(0.1), burstGroup(20),
+      btMin(1), btAlpha(1.5), btMax(10000), levelMix(4, 1.0) {}
+
+bool parseArrivalPattern(const string& name, ArrivalPattern& pattern) {
+    if (name == "poisson") pattern = ARRIVALS_POISSON;
+    else if (name == "bursty") pattern = ARRIVALS_BURSTY;
+    else return false;
+    return true;
+}
+
+// Pesos de cada cola separados por coma, por ejemplo "40,30,20,10"
+bool parseLevelMix(const string& text, vector<double>& mix) {
+    vector<double> parsed;
+    stringstream ss(text);
+    string token;
+    while (getline(ss, token, ',')) {
+        double weight = atof(token.c_str());
+        if (weight < 0) return false;
+        parsed.push_back(weight);
+    }
+    double total = 0;
+    for (size_t i = 0; i < parsed.size(); i++) total += parsed[i];
+    if (parsed.empty() || total <= 0) return false;
+    mix = parsed;
+    return true;
+}
+
+// Las transformaciones se hacen a mano sobre mt19937_64 (cuya secuencia fija
+// el estandar): las distribuciones de <random> pueden dar valores distintos
+// segun la biblioteca y la traza no seria la misma en todas las plataformas.
+class WorkloadRandom {
+private:
+    mt19937_64 engine;
+
+public:
+    explicit WorkloadRandom(unsigned long long seed) : engine(seed) {}
+
+    // Uniforme en [0, 1) con 53 bits
+    double uniform() { return (engine() >> 11) * (1.0 / 9007199254740992.0); }
+
+    // Exponencial de media 'mean'
+    double exponential(double mean) { return -log(1.0 - uniform()) * mean; }
+
+    // Pareto con minimo xm y forma alpha
+    double pareto(double xm, double alpha) { return xm / pow(1.0 - uniform(), 1.0 / alpha); }
+
+    // Entero uniforme en [low, high]
+    int range(int low, int high) { return low + (int)(uniform() * (high - low + 1)); }
+};
+
+// Buffer de salida con fwrite en bloques grandes
+class TraceWriter {
+private:
+    FILE* file;
+    vector<char> buffer;
+    size_t used;
+
+public:
+    explicit TraceWriter(FILE* f) : file(f), buffer(1 << 20), used(0) {}
+    ~TraceWriter() { flush(); }
+
+    void flush() {
+        if (used > 0) fwrite(&buffer[0], 1, used, file);
+        used = 0;
+    }
+    void text(const char* s, size_t length) {
+        if (used + length > buffer.size()) flush();
+        memcpy(&buffer[used], s, length);
+        used += length;
+    }
+    void number(long long value) {
+        if (used + 24 > buffer.size()) flush();
+        to_chars_result result = to_chars(&buffer[used], &buffer[used] + 24, value);
+        used = result.ptr - &buffer[0];
+    }
+};
+
+// Escribe 'config.count' procesos "Etiqueta;BT;AT;Q;Pr" ordenados por AT.
+// Con la misma configuracion y semilla el archivo es identico.
+bool generateWorkload(const string& filename, const WorkloadConfig& config) {
+    if (config.count < 0 || config.rate <= 0 || config.btMin < 1 || config.btAlpha <= 0 ||
+        config.btMax < config.btMin || config.burstGroup < 1) {
+        cout << "Error: parametros de carga invalidos" << endl;
+        return false;
+    }
+    FILE* file = fopen(filename.c_str(), "wb");
+    if (file == NULL) {
+        cout << "Error: No se pudo crear el archivo " << filename << endl;
+        return false;
+    }
+
+    // Distribucion acumulada de las colas
+    vector<double> cumulative(config.levelMix.size());
+    double total = 0;
+    for (size_t i = 0; i < config.levelMix.size(); i++) total += config.levelMix[i];
+    double running = 0;
+    for (size_t i = 0; i < config.levelMix.size(); i++) {
+        running += config.levelMix[i] / total;
+        cumulative[i] = running;
+    }
+
+    WorkloadRandom random(config.seed);
+    bool ok = true;
+    {
+        TraceWriter out(file);
+        string header = "# Carga sintetica: " + to_string(config.count) + " procesos, llegadas " +
+                        (config.arrivals == ARRIVALS_POISSON ? "poisson" : "bursty") +
+                        ", semilla " + to_string(config.seed) +
+                        "\n# etiqueta; burst time (BT); arrival time (AT); Queue (Q); Priority (5 > 1)\n";
+        out.text(header.data(), header.size());
+
+        // Llegadas: Poisson con tasa 'rate', o grupos de tamano geometrico
+        // (media burstGroup) que llegan juntos, con la misma tasa promedio
+        double clock = 0;
+        long long leftInGroup = 0;
+        for (long long i = 0; i < config.count; i++) {
+            if (config.arrivals == ARRIVALS_POISSON) {
+                clock += random.exponential(1.0 / config.rate);
+            } else if (leftInGroup == 0) {
+                clock += random.exponential(config.burstGroup / config.rate);
+                leftInGroup = 1 + (long long)floor(random.exponential(config.burstGroup - 0.5 > 0 ? config.burstGroup - 0.5 : 0.5));
+            }
+            if (leftInGroup > 0) leftInGroup--;
+            // El limite es el de SimTime: sin MLFQ_TIME64 el archivo no se
+            // podria simular
+            if (clock > (double)numeric_limits<SimTime>::max()) {
+                cout << "Error: los tiempos de llegada superan " << numeric_limits<SimTime>::max()
+                     << " (suba --rate, baje --count o compile con -DMLFQ_TIME64)" << endl;
+                ok = false;
+                break;
+            }
+
+            double bt = random.pareto(config.btMin, config.btAlpha);
+            int burst = bt >= config.btMax ? config.btMax : (int)ceil(bt);
+            double pick = random.uniform();
+            int level = 0;
+            while (level + 1 < (int)cumulative.size() && pick >= cumulative[level]) level++;
+            int priority = random.range(1, 5);
+
+            out.text("P", 1);
+            out.number(i + 1);
+            out.text(";", 1);
+            out.number(burst);
+            out.text(";", 1);
+            out.number((long long)clock);
+            out.text(";", 1);
+            out.number(level + 1);
+            out.text(";", 1);
+            out.number(priority);
+            out.text("\n", 1);
+        }
+    }
+    fclose(file);
+    if (ok) cout << "Carga generada: " << config.count << " procesos en " << filename << endl;
+    return ok;
+}